@@ -0,0 +1,443 @@
+// Auto-generated by scripts/generate_web_assets.py - DO NOT EDIT BY HAND
+#ifndef MAKER_API_CODEGEN_JS_H
+#define MAKER_API_CODEGEN_JS_H
+
+#include <Arduino.h>
+
+const char MAKER_API_CODEGEN_JS[] PROGMEM = R"rawliteral(
+/**
+ * MakerAPI code generators - the cURL, Disable and Override tabs.
+ * Optional feature (MAKER_API_FEATURE_CODEGEN): the dashboard loads this
+ * script only when /api/config lists it.
+ */
+
+MakerAPI.registerFeature('codegen', {
+  // Render Disable tab
+  renderDisableTab(route) {
+    const disableCode = `// This will disable ${route.path} by deregistering it\nwebPlatform.registerApiRoute("${route.path.replace('/api','')}", nullptr);`;
+    const escapedCode = this.escapeHtml(disableCode);
+    
+    return `
+      <h4>Disable This Route</h4>
+      <p>Completely disables this route by deregistering it - returns 404</p>
+      <p><strong>Usage:</strong> Add this line in your setup() function after webPlatform.begin() and any registerModule calls.</p>
+      
+      <div class="code-section">
+        <div class="code-header">
+          <button type="button" class="btn btn-small btn-primary copy-code-btn" data-code="${escapedCode}" onclick="MakerAPI.copyCode(this.dataset.code)">
+            📋 Copy Code
+          </button>
+        </div>
+        <pre class="code-block"><code>${escapedCode}</code></pre>
+      </div>
+    `;
+  },
+  
+  // Render Override tab
+  renderOverrideTab(route) {
+    const overrideCode = `// Override route: ${route.method.toUpperCase()} ${route.path}\nwebPlatform.registerApiRoute("${route.path.replace('/api','')}", customHandler, {AuthType::NONE});\n\n// Implement your custom handler:\nvoid customHandler(WebRequest& req, WebResponse& res) {\n  res.setContent("Custom response", "text/plain");\n}`;
+    const escapedCode = this.escapeHtml(overrideCode);
+    
+    return `
+      <h4>Override This Route</h4>
+      <p>Replaces route with custom handler by re-registering it</p>
+      <p><strong>Usage:</strong> Add this line and implement your custom handler function after webPlatform.begin() and any registerModule calls.</p>
+      
+      <div class="code-section">
+        <div class="code-header">
+          <button type="button" class="btn btn-small btn-primary copy-code-btn" data-code="${escapedCode}" onclick="MakerAPI.copyCode(this.dataset.code)">
+            📋 Copy Code
+          </button>
+        </div>
+        <pre class="code-block"><code>${escapedCode}</code></pre>
+      </div>
+    `;
+  },
+  
+  // Render cURL tab
+  renderCurlTab(route, routeId) {
+    const parameters = this.getRouteParameters(route);
+    const hasRequestBody = this.hasRequestBody(route);
+    const requestBodyTemplate = this.getRequestBodyTemplate(route);
+    
+    // Get authentication types - same logic as Try It tab
+    const authTypes = route.authTypes || [route.authType || route.auth || 'none'];
+    let authSelector = '';
+    
+    // Show auth selector if multiple auth types or if not 'none'
+    if (authTypes.length > 1 || (authTypes.length === 1 && authTypes[0] !== 'none')) {
+      const options = authTypes.map(authType => {
+        const label = this.getAuthLabel(authType);
+        const icon = this.getAuthIcon(authType);
+        let description = '';
+        
+        switch(authType) {
+          case 'session':
+            description = ' (Session Cookie)';
+            break;
+          case 'page_token':
+            description = ' (Page CSRF Token)';
+            break;
+          case 'token':
+            description = ' (API Token)';
+            break;
+          case 'local_only':
+            description = ' (Local Network Only)';
+            break;
+          case 'none':
+            description = ' (No authentication)';
+            break;
+        }
+        
+        return `<option value="${authType}">${icon} ${label}${description}</option>`;
+      }).join('');
+      
+      authSelector = `
+        <div class="auth-selector">
+          <h4>🔧 Authentication Method for cURL</h4>
+          <select id="${routeId}-curl-auth-type" class="form-control" onchange="MakerAPI.generateCurlCommand('${routeId}')">
+            ${options}
+          </select>
+        </div>
+      `;
+    }
+    
+    return `
+      <div class="endpoint-curl-section">
+        <h4>💻 cURL Command</h4>
+        <p>Configure parameters and authentication method. The cURL command updates automatically.</p>
+        
+        ${authSelector}
+        
+        ${parameters && parameters.length > 0 ? `
+        <div class="endpoint-parameter-section">
+          <h4>Parameters</h4>
+          <form id="${routeId}-curl-form">
+            ${parameters.map(param => this.createParameterInputForCurl(param, routeId)).join('')}
+          </form> 
+        </div>
+        ` : ''}
+        
+        <div class="endpoint-curl-actions">
+          <button type="button" class="btn btn-secondary" onclick="MakerAPI.copyCurlCommand('${routeId}')">📋 Copy to Clipboard</button>
+        </div>
+        
+        <div class="endpoint-test-results show" id="${routeId}-curl-results">
+          <h4>cURL Command</h4>
+          <div class="response-status" id="${routeId}-curl-status">
+            <span class="success">✅ cURL Command</span>
+          </div>
+          <div class="response-body" id="${routeId}-curl-output">
+            <pre><code>Generating cURL command...</code></pre>
+          </div>
+        </div>
+        
+        <script>
+          setTimeout(function() { 
+            MakerAPI.generateCurlCommand('${routeId}'); 
+          }, 50);
+        </script>
+      </div>
+    `;
+  },
+  
+  // Create parameter input for cURL tab
+  createParameterInputForCurl(param, routeId) {
+    if (!param || !param.name) {
+      console.error('Invalid parameter object:', param);
+      return '<div class="parameter-input">Invalid parameter</div>';
+    }
+    
+    const required = param.required ? ' *' : '';
+    const type = param.schema && param.schema.type ? param.schema.type : 'string';
+    const paramName = this.escapeHtml(param.name);
+    const paramDesc = param.description ? this.escapeHtml(param.description) : '';
+    
+    let inputHtml = '';
+    switch (type) {
+      case 'boolean':
+        inputHtml = `
+          <select name="${paramName}" onchange="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''}>
+            <option value="">Select...</option>
+            <option value="true">true</option>
+            <option value="false">false</option>
+          </select>
+        `;
+        break;
+      case 'integer':
+      case 'number':
+        inputHtml = `<input type="number" name="${paramName}" oninput="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''} 
+                     placeholder="${paramDesc || paramName}">`;
+        break;
+      default:
+        inputHtml = `<input type="text" name="${paramName}" oninput="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''} 
+                     placeholder="${paramDesc || paramName}">`;
+        break;
+    }
+    
+    return `
+      <div class="parameter-input">
+        <label>
+          ${paramName}${required}
+          ${paramDesc ? `<span class="param-description">${paramDesc}</span>` : ''}
+        </label>
+        ${inputHtml}
+      </div>
+    `;
+  },
+  
+  // Generate cURL command for the cURL tab
+  generateCurlCommand(routeId) {
+    const route = this.getRouteById(routeId);
+    if (!route) {
+      console.error(`Route not found: ${routeId}`);
+      return;
+    }
+    
+    // Collect current parameter values from cURL form
+    const form = document.getElementById(`${routeId}-curl-form`);
+    const paramValues = {};
+    
+    if (form) {
+      const inputs = form.querySelectorAll('input, select');
+      inputs.forEach(input => {
+        if (input.value && input.value.trim) {
+          let value = input.value.trim();
+          if (value) {
+            if (input.type === 'number') {
+              value = parseFloat(value);
+            } else if (value === 'true') {
+              value = true;
+            } else if (value === 'false') {
+              value = false;
+            }
+            paramValues[input.name] = value;
+          }
+        }
+      });
+    }
+  
+    // Build cURL command
+    let curl = `curl -X ${route.method.toUpperCase()}`;
+    
+    // Build URL with path parameters replaced
+    let urlPath = route.path;
+    const usedParams = new Set();
+    
+    // Replace path parameters (like {id})
+    Object.entries(paramValues).forEach(([key, value]) => {
+      const placeholder = `{${key}}`;
+      if (urlPath.includes(placeholder)) {
+        urlPath = urlPath.replace(placeholder, encodeURIComponent(value));
+        usedParams.add(key);
+      }
+    });
+    
+    let url = `"${window.location.origin}${urlPath}"`;
+    
+    // Add remaining parameters as query parameters for GET requests
+    if (route.method.toUpperCase() === 'GET') {
+      const queryParams = Object.entries(paramValues)
+        .filter(([key]) => !usedParams.has(key));
+        
+      if (queryParams.length > 0) {
+        const queryString = queryParams
+          .map(([key, value]) => `${encodeURIComponent(key)}=${encodeURIComponent(value)}`)
+          .join('&');
+        url = `"${window.location.origin}${urlPath}?${queryString}"`;
+      }
+    }
+    
+    curl += ` ${url}`;
+    
+    // Add headers based on auth type
+    let authType = route.authType || route.auth || 'none';
+    const authSelector = document.getElementById(`${routeId}-curl-auth-type`);
+    if (authSelector) {
+      authType = authSelector.value;
+    } else if (route.authTypes && route.authTypes.length === 1) {
+      authType = route.authTypes[0];
+    }
+    
+    if (authType === 'token') {
+      const tokenInput = document.getElementById('api-token-input');
+      const tokenValue = (tokenInput && tokenInput.value) ? tokenInput.value.trim() : '';
+      curl += ` \\\\\n  -H "Authorization: Bearer ${tokenValue}"`;
+      curl += `\n  # Note: This curl command will not send cookies, only the token header`;
+      if (!tokenValue) {
+        curl += `\n  # Note: Token is empty - select or enter token in "API Token" section above`;
+      }
+    } else if (authType === 'session' || authType === 'page_token') {
+      const csrfToken = document.querySelector('meta[name="csrf-token"]')?.getAttribute('content');
+      if (csrfToken) {
+        curl += ` \\\\\n  -H "X-CSRF-TOKEN: ${csrfToken}"`;
+        curl += ` \\\\\n  -H "X-Requested-With: XMLHttpRequest"`;
+        curl += ` \\\\\n  --cookie "your_session_cookie_here"`;
+        curl += `\n  # Note: You'll need to manually add your session cookie`;
+      }
+    } else if (authType === 'local_only') {
+      curl += `\n  # Note: This endpoint is restricted to local network access`;
+    }
+    
+    // Add body for POST/PUT/PATCH
+    if (['POST', 'PUT', 'PATCH'].includes(route.method.toUpperCase())) {
+      let bodyToSend = null;
+      
+      // Check for manual request body first
+      const bodyTextarea = document.getElementById(`${routeId}-curl-body`);
+      if (bodyTextarea && bodyTextarea.value && bodyTextarea.value.trim) {
+        const bodyValue = bodyTextarea.value.trim();
+        if (bodyValue) {
+          try {
+            bodyToSend = JSON.parse(bodyValue);
+          } catch (error) {
+            // Show error but continue with raw text
+            curl += `\n  # Warning: Request body is not valid JSON`;
+            curl += ` \\\\\n  -H "Content-Type: application/json"`;
+            curl += ` \\\\\n  -d '${bodyValue}'`;
+            this.displayCurlCommand(routeId, curl, true);
+            return;
+          }
+        }
+      } else {
+        // Fallback to form parameters (excluding path parameters)
+        const bodyParams = Object.entries(paramValues)
+          .filter(([key]) => !usedParams.has(key))
+          .reduce((obj, [key, value]) => {
+            obj[key] = value;
+            return obj;
+          }, {});
+          
+        if (Object.keys(bodyParams).length > 0) {
+          bodyToSend = bodyParams;
+        }
+      }
+      
+      if (bodyToSend) {
+        curl += ` \\\\\n  -H "Content-Type: application/json"`;
+        curl += ` \\\\\n  -d '${JSON.stringify(bodyToSend)}'`;
+      }
+    }
+    
+    // Display the command
+    this.displayCurlCommand(routeId, curl);
+  },
+  
+  // Display cURL command in the results area
+  displayCurlCommand(routeId, curl, hasWarning = false) {
+    const outputEl = document.getElementById(`${routeId}-curl-output`);
+    const statusEl = document.getElementById(`${routeId}-curl-status`);
+    
+    if (!outputEl) {
+      console.error(`curl-output element not found for ${routeId}`);
+      return;
+    }
+    
+    if (!statusEl) {
+      console.error(`curl-status element not found for ${routeId}`);
+    }
+    
+    const statusClass = hasWarning ? 'warning' : 'success';
+    const statusIcon = hasWarning ? '⚠️' : '✅';
+    
+    // Update status if element exists
+    if (statusEl) {
+      statusEl.innerHTML = `<span class="${statusClass}">${statusIcon} cURL Command${hasWarning ? ' (with warnings)' : ''}</span>`;
+    }
+    
+    // Update command display
+    outputEl.innerHTML = `<pre><code>${this.escapeHtml(curl)}</code></pre>`;
+    
+    // Store the command for copying
+    this.currentCurlCommands = this.currentCurlCommands || {};
+    this.currentCurlCommands[routeId] = curl;
+    
+  },
+  
+  // Copy current cURL command to clipboard
+  copyCurlCommand(routeId) {
+    const curlCommand = this.currentCurlCommands && this.currentCurlCommands[routeId];
+    
+    if (!curlCommand) {
+      this.showToast('No cURL command available to copy.', 'warning');
+      return;
+    }
+    
+    navigator.clipboard.writeText(curlCommand).then(() => {
+      this.showToast('cURL command copied to clipboard', 'success');
+    }).catch(err => {
+      console.error('Copy failed:', err);
+      this.showToast('Failed to copy to clipboard', 'error');
+      
+      // Fallback for browsers that don't support clipboard API
+      const textarea = document.createElement('textarea');
+      textarea.value = curlCommand;
+      textarea.style.position = 'fixed';
+      textarea.style.opacity = '0';
+      document.body.appendChild(textarea);
+      textarea.select();
+      
+      try {
+        const successful = document.execCommand('copy');
+        if (successful) {
+          this.showToast('cURL command copied to clipboard (fallback method)', 'success');
+        } else {
+          this.showToast('Copy failed with fallback method', 'error');
+        }
+      } catch (err) {
+        console.error('Fallback copy failed:', err);
+        this.showToast('Failed to copy cURL command', 'error');
+      }
+      
+      document.body.removeChild(textarea);
+    });
+  },
+  
+  // Copy code to clipboard
+  copyCode(code) {
+    if (!code) {
+      console.error('No code provided to copy');
+      this.showToast('Failed to copy: No code provided', 'error');
+      return;
+    }
+    
+    // Decode HTML entities in the code
+    const decodedCode = code.replace(/&amp;/g, '&')
+                            .replace(/&lt;/g, '<')
+                            .replace(/&gt;/g, '>')
+                            .replace(/&quot;/g, '"')
+                            .replace(/&#39;/g, "'");
+
+    navigator.clipboard.writeText(decodedCode).then(() => {
+      this.showToast('Code copied to clipboard', 'success');
+    }).catch(err => {
+      console.error('Copy failed:', err);
+      this.showToast('Failed to copy code', 'error');
+      
+      // Fallback for browsers that don't support clipboard API
+      const textarea = document.createElement('textarea');
+      textarea.value = decodedCode;
+      textarea.style.position = 'fixed';
+      textarea.style.opacity = '0';
+      document.body.appendChild(textarea);
+      textarea.select();
+      
+      try {
+        const successful = document.execCommand('copy');
+        if (successful) {
+          this.showToast('Code copied to clipboard (fallback method)', 'success');
+        } else {
+          this.showToast('Copy failed with fallback method', 'error');
+        }
+      } catch (err) {
+        console.error('Fallback copy failed:', err);
+        this.showToast('Failed to copy code', 'error');
+      }
+      
+      document.body.removeChild(textarea);
+    });
+  }
+});
+)rawliteral";
+
+#endif // MAKER_API_CODEGEN_JS_H
@@ -67,7 +67,7 @@ const char MAKER_API_DASHBOARD_HTML[] PROGMEM = R"(
             <p>Select or enter an API token to test protected endpoints.</p>
             <div class="token-controls">
                 <div class="form-group">
-                    <select id="token-selector" class="form-control token-selector">
+                    <select id="token-selector" class="form-control token-selector" style="display: none;">
                         <option value="manual">Enter token manually</option>
                         <!-- Other tokens will be loaded dynamically -->
                     </select>
@@ -106,6 +106,11 @@ const char MAKER_API_DASHBOARD_HTML[] PROGMEM = R"(
                 </div>
             </div>
             
+            <div class="batch-controls" style="display: none;">
+                <button id="run-batch" class="btn btn-secondary" disabled>📦 Run selected as batch (0)</button>
+                <div id="batch-results"></div>
+            </div>
+            
             <div id="loading-indicator" class="loading-state">
                 <div class="loading-spinner"></div>
                 <p>Loading API routes...</p>
@@ -126,6 +131,30 @@ const char MAKER_API_DASHBOARD_HTML[] PROGMEM = R"(
             </div>
         </div>
         
+        <div class="status-card" id="metrics-section">
+            <div class="metrics-header">
+                <h2>📈 Route Metrics</h2>
+                <button id="refresh-metrics" class="btn btn-secondary">🔄 Refresh</button>
+            </div>
+            <p>Request count, latency and heap use per instrumented route since boot. Polled from the device every few seconds (changes only) - not a live stream.</p>
+            <div id="metrics-container">
+                <!-- Metrics will be populated here by JavaScript -->
+            </div>
+            <h3>🔁 Main Loop</h3>
+            <p>Gaps between main loop iterations - a long gap blocks every request arriving during it.</p>
+            <div id="loop-timing-container">
+                <!-- Loop timing will be populated here by JavaScript -->
+            </div>
+            <h3>🧠 Heap</h3>
+            <p>Free heap and largest free block over time - a widening gap between them is fragmentation.</p>
+            <div id="heap-container">
+                <!-- Heap telemetry will be populated here by JavaScript -->
+            </div>
+            <h3>🧵 Request Trace</h3>
+            <p>The most recent requests as a Chrome trace - open it in <a href="https://ui.perfetto.dev" target="_blank" rel="noopener">Perfetto</a>. Recording is enabled in firmware with <code>makerAPI.setRequestTracing(true)</code>.</p>
+            <button id="download-trace" class="btn btn-secondary">📥 Download Trace</button>
+        </div>
+        
         <div class="footer">
             <p>Maker API Dashboard - OpenAPI 3.0 Compatible</p>
             <p>Device: <strong>{{DEVICE_NAME}}</strong> | User: <strong>{{username}}</strong></p>
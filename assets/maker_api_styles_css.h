@@ -499,6 +499,11 @@ const char MAKER_API_STYLES_CSS[] PROGMEM = R"(
   color: #FFE0B2;
 }
 
+.api-auth-page_token {
+  background: rgba(255, 193, 7, 0.3);
+  color: #FFECB3;
+}
+
 .api-auth-token {
   background: rgba(244, 67, 54, 0.3);
   color: #FFCDD2;
@@ -1226,6 +1231,206 @@ const char MAKER_API_STYLES_CSS[] PROGMEM = R"(
   min-width: 120px;
 }
 
+/* Batch runs */
+.batch-controls {
+  margin-bottom: 15px;
+}
+
+.batch-select {
+  margin-right: 8px;
+  cursor: pointer;
+}
+
+.batch-result {
+  margin-top: 10px;
+}
+
+.batch-result pre {
+  max-height: 200px;
+  overflow: auto;
+}
+
+/* Route metrics */
+.metrics-header {
+  display: flex;
+  justify-content: space-between;
+  align-items: center;
+  gap: 10px;
+}
+
+.metrics-table {
+  width: 100%;
+  border-collapse: collapse;
+  font-size: 0.9em;
+}
+
+.metrics-table th,
+.metrics-table td {
+  padding: 6px 8px;
+  text-align: left;
+  border-bottom: 1px solid rgba(255, 255, 255, 0.1);
+}
+
+.metrics-table th {
+  color: rgba(255, 255, 255, 0.7);
+  font-weight: 600;
+}
+
+.metrics-table td:nth-child(n+3) {
+  font-family: 'Courier New', monospace;
+  text-align: right;
+}
+
+.metrics-row {
+  cursor: pointer;
+}
+
+.metrics-row:hover {
+  background: rgba(255, 255, 255, 0.05);
+}
+
+.metrics-chart-row td {
+  padding: 10px 8px;
+}
+
+.metrics-histogram {
+  height: 80px;
+}
+
+.load-test-bar.loop-gap-slow {
+  background: #f44336;
+}
+
+.heap-chart {
+  width: 100%;
+  height: 120px;
+  background: rgba(0, 0, 0, 0.3);
+  border: 1px solid rgba(255, 255, 255, 0.1);
+  border-radius: 6px;
+}
+
+.heap-chart polyline {
+  fill: none;
+  stroke-width: 2;
+  vector-effect: non-scaling-stroke;
+}
+
+.heap-line-free {
+  stroke: #4CAF50;
+}
+
+.heap-line-largest {
+  stroke: #FF9800;
+}
+
+.heap-legend-free {
+  color: #4CAF50;
+}
+
+.heap-legend-largest {
+  color: #FF9800;
+}
+
+/* Request timing breakdown */
+.timing-breakdown {
+  margin-bottom: 10px;
+  font-family: 'Courier New', monospace;
+  font-size: 0.85em;
+}
+
+.timing-row {
+  display: flex;
+  align-items: center;
+  gap: 10px;
+  padding: 2px 0;
+}
+
+.timing-label {
+  flex: 0 0 130px;
+  color: rgba(255, 255, 255, 0.8);
+}
+
+.timing-bar {
+  flex: 1;
+  height: 8px;
+  background: rgba(0, 0, 0, 0.3);
+  border-radius: 4px;
+  overflow: hidden;
+}
+
+.timing-bar span {
+  display: block;
+  height: 100%;
+  background: #4CAF50;
+}
+
+.timing-value {
+  flex: 0 0 80px;
+  text-align: right;
+}
+
+/* Load test */
+.load-test-section {
+  margin-top: 20px;
+  border-top: 1px solid rgba(255, 255, 255, 0.1);
+  padding-top: 15px;
+}
+
+.load-test-section summary {
+  cursor: pointer;
+  font-weight: 600;
+  margin-bottom: 10px;
+}
+
+.load-test-controls {
+  display: flex;
+  gap: 10px;
+  flex-wrap: wrap;
+  margin-bottom: 15px;
+}
+
+.load-test-controls label {
+  flex: 1;
+  min-width: 140px;
+  font-size: 0.85em;
+  color: rgba(255, 255, 255, 0.8);
+}
+
+.load-test-stats {
+  display: grid;
+  grid-template-columns: repeat(auto-fit, minmax(110px, 1fr));
+  gap: 8px;
+  margin-bottom: 15px;
+  font-family: 'Courier New', monospace;
+  font-size: 0.9em;
+}
+
+.load-test-histogram {
+  display: flex;
+  align-items: flex-end;
+  gap: 2px;
+  height: 100px;
+  background: rgba(0, 0, 0, 0.3);
+  border: 1px solid rgba(255, 255, 255, 0.1);
+  border-radius: 6px;
+  padding: 5px;
+}
+
+.load-test-bar {
+  flex: 1;
+  min-height: 1px;
+  background: #2196F3;
+  border-radius: 2px 2px 0 0;
+}
+
+.load-test-histogram-axis {
+  display: flex;
+  justify-content: space-between;
+  font-size: 0.75em;
+  color: rgba(255, 255, 255, 0.5);
+  margin-top: 4px;
+}
+
 /* Animation for tab transitions */
 @keyframes fadeIn {
   from {
@@ -0,0 +1,150 @@
+// Auto-generated by scripts/generate_web_assets.py - DO NOT EDIT BY HAND
+#ifndef MAKER_API_SW_JS_H
+#define MAKER_API_SW_JS_H
+
+#include <Arduino.h>
+
+const char MAKER_API_SW_JS[] PROGMEM = R"(
+/**
+ * MakerAPI Service Worker
+ * Registered with the module prefix as its scope, so it only controls the
+ * API explorer page and never sees other WebPlatform modules' pages.
+ *
+ * - Dashboard assets are cached per asset fingerprint (?v=) and served
+ *   cache-first - the core ones precached, optional feature scripts on first
+ *   use; a new firmware build means a new fingerprint, a new worker and a
+ *   fresh cache.
+ * - The dashboard page, /api/config and the OpenAPI specs are served
+ *   stale-while-revalidate. Spec revalidation is conditional (If-None-Match
+ *   with the cached ETag), so an unchanged spec costs the device a 304.
+ */
+
+const SCOPE = self.registration.scope;
+const SCOPE_PATH = new URL(SCOPE).pathname;
+const ASSET_VERSION = new URL(self.location.href).searchParams.get('v') || 'dev';
+const CACHE_PREFIX = `maker-api:${SCOPE_PATH}:`;
+const ASSET_CACHE = `${CACHE_PREFIX}assets:${ASSET_VERSION}`;
+const DATA_CACHE = `${CACHE_PREFIX}data`;
+
+const PRECACHE_ASSETS = [
+  'assets/maker-api-style.css',
+  'assets/maker-api-utils.js',
+  'assets/maker-api-spec-worker.js'
+].map(path => new URL(path, SCOPE).href);
+
+// Optional feature scripts vary by build, so they are cached on first use
+const ASSET_PREFIX = new URL('assets/maker-api-', SCOPE).href;
+
+const PAGE_URL = new URL('./', SCOPE).href;
+const CONFIG_URL = new URL('api/config', SCOPE).href;
+const SPEC_PATHS = ['/openapi.json', '/maker/openapi.json', new URL('openapi.json', SCOPE).pathname];
+
+self.addEventListener('install', (event) => {
+  event.waitUntil(
+    caches.open(ASSET_CACHE)
+      .then(cache => cache.addAll(PRECACHE_ASSETS))
+      .then(() => self.skipWaiting())
+  );
+});
+
+self.addEventListener('activate', (event) => {
+  // Drop asset caches from previous firmware builds under this scope only
+  event.waitUntil(
+    caches.keys()
+      .then(keys => Promise.all(keys
+        .filter(key => key.startsWith(`${CACHE_PREFIX}assets:`) && key !== ASSET_CACHE)
+        .map(key => caches.delete(key))))
+      .then(() => self.clients.claim())
+  );
+});
+
+self.addEventListener('fetch', (event) => {
+  const request = event.request;
+  const url = new URL(request.url);
+
+  if (url.origin !== self.location.origin) return;
+
+  if (request.method === 'POST' && request.url === CONFIG_URL) {
+    // POST responses can't be cached directly - keep the last one under a
+    // synthetic GET key
+    event.respondWith(staleWhileRevalidate(event, request, new Request(CONFIG_URL)));
+    return;
+  }
+
+  if (request.method !== 'GET') return;
+
+  if ((url.origin + url.pathname).startsWith(ASSET_PREFIX)) {
+    event.respondWith(cacheFirst(request));
+  } else if (request.mode === 'navigate' && url.href.split(/[?#]/)[0] === PAGE_URL) {
+    event.respondWith(staleWhileRevalidate(event, request, new Request(PAGE_URL)));
+  } else if (SPEC_PATHS.includes(url.pathname)) {
+    event.respondWith(staleWhileRevalidate(event, request, new Request(url.origin + url.pathname), true));
+  }
+  // Anything else (API calls from Try It, other modules) goes to the network untouched
+});
+
+async function cacheFirst(request) {
+  const cache = await caches.open(ASSET_CACHE);
+  const cached = await cache.match(request, { ignoreSearch: true });
+  if (cached) return cached;
+
+  const response = await fetch(request);
+  if (response.ok) {
+    cache.put(request, response.clone());
+  }
+  return response;
+}
+
+// Serve the cached copy immediately (if any) and refresh it in the background.
+// When notifyOnChange is set, clients are told once a changed body has landed.
+async function staleWhileRevalidate(event, request, cacheKey, notifyOnChange = false) {
+  const cache = await caches.open(DATA_CACHE);
+  const cached = await cache.match(cacheKey);
+
+  const revalidation = revalidate(cache, request, cacheKey, cached, notifyOnChange);
+
+  if (cached) {
+    event.waitUntil(revalidation.catch(() => {}));
+    return cached;
+  }
+
+  return revalidation;
+}
+
+async function revalidate(cache, request, cacheKey, cached, notifyOnChange) {
+  const etag = cached ? cached.headers.get('ETag') : null;
+  let networkRequest = request.clone();
+
+  if (etag && request.method === 'GET') {
+    // Navigation requests can't be re-wrapped, so build a plain GET
+    const headers = new Headers(request.headers);
+    headers.set('If-None-Match', etag);
+    networkRequest = new Request(request.url, { headers, credentials: 'include' });
+  }
+
+  const response = await fetch(networkRequest);
+
+  if (response.status === 304 && cached) {
+    return cached;
+  }
+
+  if (response.ok) {
+    const changed = !cached || etag || await bodyChanged(cached, response);
+    await cache.put(cacheKey, response.clone());
+    if (cached && changed && notifyOnChange) {
+      const clients = await self.clients.matchAll();
+      clients.forEach(client => client.postMessage({ type: 'spec-updated', url: cacheKey.url }));
+    }
+  }
+
+  return response;
+}
+
+// Without an ETag a 200 says nothing about change - compare the bodies
+async function bodyChanged(cached, response) {
+  const [before, after] = await Promise.all([cached.clone().text(), response.clone().text()]);
+  return before !== after;
+}
+)";
+
+#endif // MAKER_API_SW_JS_H
@@ -0,0 +1,190 @@
+// Auto-generated by scripts/generate_web_assets.py - DO NOT EDIT BY HAND
+#ifndef MAKER_API_TOKENS_JS_H
+#define MAKER_API_TOKENS_JS_H
+
+#include <Arduino.h>
+
+const char MAKER_API_TOKENS_JS[] PROGMEM = R"(
+/**
+ * MakerAPI token picker - offers the signed-in user's API tokens next to
+ * the manual token field.
+ * Optional feature (MAKER_API_FEATURE_TOKENS): the dashboard loads this
+ * script only when /api/config lists it.
+ */
+
+MakerAPI.registerFeature('tokens', {
+  // Show the token picker and fill it with the user's tokens in the
+  // background - never blocks the first render
+  setupTokenPicker() {
+    const tokenSelector = document.getElementById('token-selector');
+    if (tokenSelector) {
+      tokenSelector.style.display = '';
+      tokenSelector.addEventListener('change', (e) => this.onTokenSelectionChange(e));
+    }
+    
+    this.updateTokenSelector();
+    this.loadAvailableTokens().catch(error => {
+      console.warn('Token loading failed but continuing with app initialization:', error);
+    });
+  },
+  
+  // Load available tokens for the current user
+  async loadAvailableTokens() {
+    try {
+      // Always make sure the selector is initialized first, so UI works regardless
+      this.state.availableTokens = [];
+      this.updateTokenSelector();
+      
+      // Try to get the user's tokens if we're logged in
+      try {
+        // First check if we're logged in by getting current user
+        const userResponse = await fetch('/api/user', {
+          method: 'GET',
+          headers: {
+            'Accept': 'application/json',
+            'X-Requested-With': 'XMLHttpRequest'
+          },
+          credentials: 'include'
+        });
+        
+        if (!userResponse.ok) {
+          return;
+        }
+        
+        // Parse the user data - the ID might be in different locations depending on API structure
+        const userData = await userResponse.json();
+        let userId = null;
+        
+        // Look for ID in different possible locations
+        if (userData.id) {
+          userId = userData.id;
+        } else if (userData.user && userData.user.id) {
+          userId = userData.user.id;
+        } else if (userData.data && userData.data.id) {
+          userId = userData.data.id;
+        }
+        
+        // Try to use the userData object directly if we couldn't find an ID
+        if (!userId && userData) {
+          
+          // Try the /api/tokens endpoint first as fallback
+          const tokensResponse = await fetch('/api/tokens', {
+            method: 'GET',
+            headers: {
+              'Accept': 'application/json',
+              'X-Requested-With': 'XMLHttpRequest'
+            },
+            credentials: 'include'
+          });
+          
+          if (tokensResponse.ok) {
+            const tokensData = await tokensResponse.json();
+            if (tokensData.tokens && tokensData.tokens.length > 0) {
+              this.state.availableTokens = tokensData.tokens;
+              this.updateTokenSelector();
+              return;
+            }
+          }
+          
+          return;
+        }
+        
+        
+        // Now fetch tokens for this user
+        const tokensResponse = await fetch(`/api/users/${userId}/tokens`, {
+          method: 'GET',
+          headers: {
+            'Accept': 'application/json',
+            'X-Requested-With': 'XMLHttpRequest'
+          },
+          credentials: 'include'
+        });
+        
+        if (tokensResponse.ok) {
+          const tokensData = await tokensResponse.json();
+          this.state.availableTokens = tokensData.tokens || [];
+          this.updateTokenSelector();
+        } else {
+          console.warn(`Failed to load tokens: ${tokensResponse.status} ${tokensResponse.statusText}`);
+        }
+      } catch (innerError) {
+        console.warn('Error while trying to load tokens:', innerError);
+      }
+    } catch (error) {
+      console.warn('Failed to load available tokens (outer error):', error);
+    }
+  },
+  
+  // Update the token selector dropdown
+  updateTokenSelector() {
+    const tokenSelector = document.getElementById('token-selector');
+    const tokenInput = document.getElementById('api-token-input');
+    
+    if (!tokenSelector) return;
+    
+    // Clear existing options
+    tokenSelector.innerHTML = '<option value="manual">Enter token manually</option>';
+    
+    // Add existing tokens
+    if (this.state.availableTokens && this.state.availableTokens.length > 0) {
+      this.state.availableTokens.forEach(token => {
+        const option = document.createElement('option');
+        option.value = token.value || token.token;  // Handle different API formats
+        option.textContent = `🔑 ${token.name}${token.description ? ` - ${token.description}` : ''}`;
+        tokenSelector.appendChild(option);
+      });
+    }
+    
+    // Set default to manual entry
+    tokenSelector.value = 'manual';
+    
+    // Initial state setup
+    if (tokenInput) {
+      tokenInput.disabled = false;
+      tokenInput.placeholder = 'Enter your API token here...';
+    }
+    
+    // Update CSS to properly format the token section
+    this.updateTokenSectionStyles();
+  },
+  
+  // Update token section - styles now handled in CSS file
+  updateTokenSectionStyles() {
+    // Token section styling is now handled in maker_api_styles_css.h
+    // This function remains for any future dynamic styling needs
+  },
+  
+  // Handle token selection change
+  onTokenSelectionChange(event) {
+    const tokenInput = document.getElementById('api-token-input');
+    if (!tokenInput) return;
+    
+    const selectedValue = event.target.value;
+    
+    if (selectedValue === 'manual') {
+      // Enable manual entry
+      tokenInput.disabled = false;
+      tokenInput.value = '';
+      tokenInput.placeholder = 'Enter your API token here...';
+      this.state.token = null;
+      this.showToast('Enter your token manually', 'info');
+    } else {
+      // Use selected token
+      tokenInput.disabled = true;
+      tokenInput.value = selectedValue;
+      tokenInput.placeholder = '';
+      this.state.token = selectedValue;
+      
+      // Find the token name from our list
+      const selectedToken = this.state.availableTokens.find(t => 
+        (t.value && t.value === selectedValue) || (t.token && t.token === selectedValue)
+      );
+      const tokenName = selectedToken ? selectedToken.name : 'Selected token';
+      
+      this.showToast(`Using token: ${tokenName}`, 'success');
+    }
+  }
+});
+)";
+
+#endif // MAKER_API_TOKENS_JS_H
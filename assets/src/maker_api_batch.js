@@ -0,0 +1,99 @@
+/**
+ * MakerAPI batch runs - select routes and call them in one /api/batch request.
+ * Optional feature (MAKER_API_FEATURE_BATCH, which also provides /api/batch):
+ * the dashboard loads this script only when /api/config lists it.
+ */
+
+MakerAPI.registerFeature('batch', {
+  // Show the batch controls (hidden in builds without the feature)
+  setupBatch() {
+    const controls = document.querySelector('.batch-controls');
+    if (controls) {
+      controls.style.display = '';
+    }
+    
+    const batchBtn = document.getElementById('run-batch');
+    if (batchBtn) {
+      batchBtn.addEventListener('click', () => this.runBatch());
+    }
+  },
+  
+  // The dashboard sends each selected route without parameters or a body,
+  // so only routes that need neither can be selected
+  renderBatchCheckbox(route, routeId) {
+    const batchable = this.getRouteParameters(route).length === 0 && !this.hasRequestBody(route);
+    const checked = this.state.batchSelection.has(routeId) ? 'checked' : '';
+    return `<input type="checkbox" class="batch-select" ${batchable ? checked : 'disabled'}
+      title="${batchable ? 'Select for batch run' : 'Routes with parameters or a body cannot be batched'}"
+      onclick="event.stopPropagation()" onchange="MakerAPI.toggleBatchSelection('${routeId}', this.checked)">`;
+  },
+  
+  toggleBatchSelection(routeId, selected) {
+    if (selected) {
+      this.state.batchSelection.add(routeId);
+    } else {
+      this.state.batchSelection.delete(routeId);
+    }
+    this.updateBatchButton();
+  },
+  
+  updateBatchButton() {
+    const button = document.getElementById('run-batch');
+    if (!button) return;
+    const count = this.state.batchSelection.size;
+    button.disabled = count === 0;
+    button.textContent = `📦 Run selected as batch (${count})`;
+  },
+  
+  // Run the selected routes through /api/batch - one request (and one TLS
+  // handshake) for all of them
+  async runBatch() {
+    const resultsEl = document.getElementById('batch-results');
+    const routes = Array.from(this.state.batchSelection)
+      .map(routeId => this.getRouteById(routeId))
+      .filter(Boolean);
+    if (!resultsEl || routes.length === 0) return;
+    
+    const calls = routes.map(route => ({ method: route.method.toUpperCase(), path: route.path }));
+    resultsEl.innerHTML = '<p>Running batch...</p>';
+    
+    try {
+      const modulePrefix = AuthUtils.getModulePrefix();
+      const startTime = performance.now();
+      const response = await AuthUtils.fetch(`${modulePrefix}/api/batch`, {
+        method: 'POST',
+        headers: {
+          'Accept': 'application/json',
+          'Content-Type': 'application/json',
+          'X-Requested-With': 'XMLHttpRequest'
+        },
+        credentials: 'include',
+        body: JSON.stringify(calls)
+      });
+      const duration = Math.round(performance.now() - startTime);
+      const result = await response.json();
+      if (!response.ok) {
+        throw new Error(result.error || `HTTP ${response.status}`);
+      }
+      
+      resultsEl.innerHTML = `
+        <div class="response-status">
+          <span class="success">✅ ${calls.length} call(s) in one request (${duration}ms)</span>
+        </div>
+        ${result.responses.map(call => `
+          <div class="batch-result">
+            <div class="response-status">
+              <span class="${call.status >= 200 && call.status < 300 ? 'success' : 'error'}">
+                <span class="api-method ${call.method.toLowerCase()}">${call.method}</span>
+                ${this.escapeHtml(call.path)} - ${call.status}${call.error ? ` ${this.escapeHtml(call.error)}` : ''} (${this.formatMicros(call.durationUs)})
+              </span>
+            </div>
+            ${call.error ? '' : `<pre><code>${this.escapeHtml(typeof call.body === 'string' ? call.body : JSON.stringify(call.body, null, 2))}</code></pre>`}
+          </div>
+        `).join('')}
+      `;
+    } catch (error) {
+      resultsEl.innerHTML = `<p class="error">❌ Batch failed: ${this.escapeHtml(error.message)}</p>`;
+    }
+  }
+});
@@ -0,0 +1,263 @@
+/**
+ * MakerAPI load test and on-device benchmark for the Try It tab.
+ * Optional feature (MAKER_API_FEATURE_LOAD_TEST, which also provides
+ * /api/benchmark): the dashboard loads this script only when /api/config
+ * lists it.
+ */
+
+MakerAPI.registerFeature('load-test', {
+  // Load test limits - concurrency is capped so a test can't exhaust the
+  // device's few HTTP sockets and wedge it
+  loadTestLimits: {
+    maxRequests: 1000,
+    maxConcurrency: 4,
+    maxRate: 50,
+    histogramBins: 20
+  },
+  
+  // Time the handler itself: /api/benchmark runs it in-process on the
+  // device, so Wi-Fi and TLS drop out of the numbers
+  async runDeviceBenchmark(routeId) {
+    const route = this.getRouteById(routeId);
+    const resultsEl = document.getElementById(`${routeId}-bench-results`);
+    const button = document.getElementById(`${routeId}-bench-btn`);
+    if (!route || !resultsEl) return;
+    
+    if (button) button.disabled = true;
+    resultsEl.innerHTML = '<p>Benchmarking on device...</p>';
+    
+    try {
+      const modulePrefix = AuthUtils.getModulePrefix();
+      const response = await AuthUtils.fetch(`${modulePrefix}/api/benchmark`, {
+        method: 'POST',
+        headers: {
+          'Accept': 'application/json',
+          'Content-Type': 'application/json',
+          'X-Requested-With': 'XMLHttpRequest'
+        },
+        credentials: 'include',
+        body: JSON.stringify({ method: route.method.toUpperCase(), path: route.path, iterations: 20 })
+      });
+      const result = await response.json();
+      if (!response.ok) {
+        throw new Error(result.error || `HTTP ${response.status}`);
+      }
+      
+      const us = this.formatMicros;
+      const summary = result.summary;
+      const times = result.iterations.map(iteration => iteration[0]);
+      const peak = Math.max(1, ...times);
+      
+      resultsEl.innerHTML = `
+        <div class="response-status">
+          <span class="success">✅ ${summary.iterations} iterations on device</span>
+        </div>
+        <div class="load-test-stats">
+          <div><strong>avg</strong> ${us(summary.avgUs)}</div>
+          <div><strong>p50</strong> ${us(summary.p50Us)}</div>
+          <div><strong>p90</strong> ${us(summary.p90Us)}</div>
+          <div><strong>min</strong> ${us(summary.minUs)}</div>
+          <div><strong>max</strong> ${us(summary.maxUs)}</div>
+          <div><strong>heap max</strong> ${summary.heapDeltaMax}B</div>
+          <div><strong>response</strong> ${this.formatBytes(summary.bytes)}</div>
+        </div>
+        <div class="load-test-histogram">
+          ${result.iterations.map(([micros, heapDelta, bytes]) => `<div class="load-test-bar" style="height: ${(micros / peak) * 100}%" title="${us(micros)}, heap ${heapDelta}B, ${bytes}B"></div>`).join('')}
+        </div>
+        <div class="load-test-histogram-axis"><span>first</span><span>last</span></div>
+      `;
+    } catch (error) {
+      resultsEl.innerHTML = `<p class="error">❌ Benchmark failed: ${this.escapeHtml(error.message)}</p>`;
+    } finally {
+      if (button) button.disabled = false;
+    }
+  },
+  
+  // Render the load test controls for the Try It tab
+  renderLoadTestSection(routeId) {
+    const limits = this.loadTestLimits;
+    
+    return `
+      <details class="load-test-section" id="${routeId}-load-test">
+        <summary>📈 Load Test</summary>
+        <p>Sends the request above repeatedly using the same parameters, body and authentication.</p>
+        <div class="load-test-controls">
+          <label>Requests
+            <input type="number" id="${routeId}-lt-count" class="form-control" value="50" min="1" max="${limits.maxRequests}">
+          </label>
+          <label>Concurrency (max ${limits.maxConcurrency})
+            <input type="number" id="${routeId}-lt-concurrency" class="form-control" value="1" min="1" max="${limits.maxConcurrency}">
+          </label>
+          <label>Rate limit (req/s, 0 = none)
+            <input type="number" id="${routeId}-lt-rate" class="form-control" value="0" min="0" max="${limits.maxRate}">
+          </label>
+        </div>
+        <div class="endpoint-test-actions">
+          <button type="button" class="btn btn-primary" id="${routeId}-lt-start" onclick="MakerAPI.runLoadTest('${routeId}')">Run Load Test</button>
+          <button type="button" class="btn btn-secondary" id="${routeId}-lt-stop" onclick="MakerAPI.stopLoadTest('${routeId}')" disabled>Stop</button>
+        </div>
+        <div class="load-test-results" id="${routeId}-lt-results"></div>
+      </details>
+    `;
+  },
+  
+  // Run a load test against a route: N requests at a capped concurrency,
+  // optionally paced to a request rate
+  async runLoadTest(routeId) {
+    const route = this.getRouteById(routeId);
+    const resultsEl = document.getElementById(`${routeId}-lt-results`);
+    const startBtn = document.getElementById(`${routeId}-lt-start`);
+    const stopBtn = document.getElementById(`${routeId}-lt-stop`);
+    if (!route || !resultsEl || !startBtn || !stopBtn) return;
+    
+    const limits = this.loadTestLimits;
+    const readInput = (suffix, min, max, fallback) => {
+      const el = document.getElementById(`${routeId}-lt-${suffix}`);
+      const value = el ? parseInt(el.value, 10) : NaN;
+      return Math.min(max, Math.max(min, Number.isNaN(value) ? fallback : value));
+    };
+    const total = readInput('count', 1, limits.maxRequests, 50);
+    const concurrency = readInput('concurrency', 1, limits.maxConcurrency, 1);
+    const rate = readInput('rate', 0, limits.maxRate, 0);
+    
+    const built = this.buildTestRequest(routeId, route);
+    if (built.error) {
+      resultsEl.innerHTML = `<span class="error">❌ ${this.escapeHtml(built.error)}</span>`;
+      return;
+    }
+    
+    const run = {
+      total,
+      concurrency,
+      latencies: [],
+      errors: 0,
+      issued: 0,
+      stopped: false,
+      started: performance.now(),
+      finished: null,
+      renderPending: false
+    };
+    this.loadTests = this.loadTests || {};
+    this.loadTests[routeId] = run;
+    
+    startBtn.disabled = true;
+    stopBtn.disabled = false;
+    
+    const interval = rate > 0 ? 1000 / rate : 0;
+    const sleep = ms => new Promise(resolve => setTimeout(resolve, ms));
+    
+    const worker = async () => {
+      while (!run.stopped && run.issued < run.total) {
+        const index = run.issued++;
+        
+        if (interval) {
+          const wait = run.started + index * interval - performance.now();
+          if (wait > 0) await sleep(wait);
+          if (run.stopped) break;
+        }
+        
+        const t0 = performance.now();
+        try {
+          const response = await fetch(built.url, built.options);
+          await response.arrayBuffer();
+          if (!response.ok) run.errors++;
+        } catch (error) {
+          run.errors++;
+        }
+        run.latencies.push(performance.now() - t0);
+        this.scheduleLoadTestRender(routeId);
+      }
+    };
+    
+    await Promise.all(Array.from({ length: concurrency }, worker));
+    
+    run.finished = performance.now();
+    startBtn.disabled = false;
+    stopBtn.disabled = true;
+    this.renderLoadTestResults(routeId);
+  },
+  
+  stopLoadTest(routeId) {
+    const run = this.loadTests && this.loadTests[routeId];
+    if (run) run.stopped = true;
+  },
+  
+  // Coalesce live result updates to one per animation frame
+  scheduleLoadTestRender(routeId) {
+    const run = this.loadTests[routeId];
+    if (run.renderPending) return;
+    run.renderPending = true;
+    requestAnimationFrame(() => {
+      run.renderPending = false;
+      this.renderLoadTestResults(routeId);
+    });
+  },
+  
+  // Summarize latencies: percentiles use the nearest-rank method
+  computeLoadTestStats(run) {
+    const sorted = run.latencies.slice().sort((a, b) => a - b);
+    const count = sorted.length;
+    const elapsed = ((run.finished || performance.now()) - run.started) / 1000;
+    const percentile = p => count ? sorted[Math.min(count - 1, Math.max(0, Math.ceil(p / 100 * count) - 1))] : 0;
+    
+    return {
+      count,
+      sorted,
+      p50: percentile(50),
+      p90: percentile(90),
+      p99: percentile(99),
+      max: count ? sorted[count - 1] : 0,
+      errorRate: count ? (run.errors / count) * 100 : 0,
+      throughput: elapsed > 0 ? count / elapsed : 0
+    };
+  },
+  
+  renderLoadTestResults(routeId) {
+    const run = this.loadTests[routeId];
+    const resultsEl = document.getElementById(`${routeId}-lt-results`);
+    if (!run || !resultsEl) return;
+    
+    const stats = this.computeLoadTestStats(run);
+    const ms = value => `${value.toFixed(1)}ms`;
+    const state = run.finished ? (run.stopped ? 'Stopped' : 'Done') : 'Running';
+    
+    resultsEl.innerHTML = `
+      <div class="response-status">
+        <span class="${stats.errorRate > 0 ? 'error' : 'success'}">${state}: ${stats.count}/${run.total} requests, concurrency ${run.concurrency}</span>
+      </div>
+      <div class="load-test-stats">
+        <div><strong>p50</strong> ${ms(stats.p50)}</div>
+        <div><strong>p90</strong> ${ms(stats.p90)}</div>
+        <div><strong>p99</strong> ${ms(stats.p99)}</div>
+        <div><strong>max</strong> ${ms(stats.max)}</div>
+        <div><strong>errors</strong> ${stats.errorRate.toFixed(1)}%</div>
+        <div><strong>throughput</strong> ${stats.throughput.toFixed(1)} req/s</div>
+      </div>
+      ${this.renderLatencyHistogram(stats.sorted)}
+    `;
+  },
+  
+  // Fixed-width latency histogram from min to max
+  renderLatencyHistogram(sorted) {
+    if (sorted.length === 0) return '';
+    
+    const bins = this.loadTestLimits.histogramBins;
+    const min = sorted[0];
+    const width = Math.max((sorted[sorted.length - 1] - min) / bins, 0.001);
+    const counts = new Array(bins).fill(0);
+    sorted.forEach(value => {
+      counts[Math.min(bins - 1, Math.floor((value - min) / width))]++;
+    });
+    const peak = Math.max(...counts);
+    
+    const bars = counts.map((count, i) => {
+      const from = min + i * width;
+      return `<div class="load-test-bar" style="height: ${(count / peak) * 100}%" title="${from.toFixed(1)}-${(from + width).toFixed(1)}ms: ${count}"></div>`;
+    }).join('');
+    
+    return `
+      <div class="load-test-histogram">${bars}</div>
+      <div class="load-test-histogram-axis"><span>${min.toFixed(1)}ms</span><span>${(min + width * bins).toFixed(1)}ms</span></div>
+    `;
+  }
+});
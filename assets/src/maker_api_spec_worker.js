@@ -0,0 +1,433 @@
+/**
+ * MakerAPI Spec Worker
+ * Fetches, decodes and indexes the OpenAPI specification off the main thread
+ * and posts back a compact route model. The same file is also loadable as a
+ * classic script, so the dashboard can fall back to main-thread parsing in
+ * browsers without Worker support.
+ */
+
+const MakerAPISpecParser = {
+  // Last model built per spec URL - the base for incremental refreshes
+  snapshots: new Map(),
+
+  // Fetch a spec and build the route model from it
+  async load(url) {
+    const fetched = await this.fetchSpec(url, null);
+    const model = this.buildModel(fetched.spec, fetched.version);
+    this.remember(url, model, fetched.etag);
+    return model;
+  },
+
+  // Fetch a spec and describe how it differs from the model with the given
+  // version. Replies with {delta} when that model is still known, otherwise
+  // with a full {model}.
+  async refresh(url, sinceVersion) {
+    const snapshot = this.snapshots.get(url);
+    const base = snapshot && snapshot.version === sinceVersion ? snapshot : null;
+
+    const fetched = await this.fetchSpec(url, base ? base.etag : null);
+    if (fetched.notModified || (base && fetched.version === base.version)) {
+      return { delta: { version: base.version, added: [], changed: [], removed: [] } };
+    }
+
+    const model = this.buildModel(fetched.spec, fetched.version);
+    this.remember(url, model, fetched.etag);
+
+    if (!base) {
+      return { model };
+    }
+
+    const delta = {
+      version: model.version,
+      info: model.info,
+      allTags: model.allTags,
+      added: [],
+      changed: [],
+      removed: []
+    };
+
+    const next = new Map();
+    model.routes.forEach(route => {
+      const key = this.routeKey(route);
+      next.set(key, route);
+      const previous = base.hashes.get(key);
+      if (previous === undefined) {
+        delta.added.push(route);
+      } else if (previous !== route.hash) {
+        delta.changed.push(route);
+      }
+    });
+    base.routes.forEach((route, key) => {
+      if (!next.has(key)) {
+        delta.removed.push({ path: route.path, method: route.method });
+      }
+    });
+
+    return { delta };
+  },
+
+  async fetchSpec(url, etag) {
+    const headers = {
+      'Accept': 'application/json',
+      'Cache-Control': 'no-cache'
+    };
+    if (etag) {
+      headers['If-None-Match'] = etag;
+    }
+
+    const response = await fetch(url, {
+      method: 'GET',
+      headers: headers,
+      credentials: 'include'
+    });
+
+    if (response.status === 304) {
+      return { notModified: true };
+    }
+
+    if (!response.ok) {
+      throw new Error(`Failed to fetch OpenAPI spec: HTTP ${response.status} ${response.statusText}`);
+    }
+
+    const text = await response.text();
+    const spec = JSON.parse(text);
+
+    // Validate the spec has the required structure
+    if (!spec.paths) {
+      throw new Error('Invalid OpenAPI spec: missing "paths" property');
+    }
+
+    return { spec, version: this.hash(text), etag: response.headers.get('ETag') };
+  },
+
+  remember(url, model, etag) {
+    const routes = new Map();
+    const hashes = new Map();
+    model.routes.forEach(route => {
+      const key = this.routeKey(route);
+      routes.set(key, route);
+      hashes.set(key, route.hash);
+    });
+    this.snapshots.set(url, { version: model.version, etag, routes, hashes });
+  },
+
+  // Build the compact model posted back to the dashboard
+  buildModel(spec, version) {
+    const routes = this.parseRoutes(spec);
+
+    return {
+      version: version,
+      info: spec.info ? { title: spec.info.title, version: spec.info.version } : null,
+      routes: routes,
+      allTags: this.collectTags(routes)
+    };
+  },
+
+  routeKey(route) {
+    return `${route.method} ${route.path}`;
+  },
+
+  // 32-bit FNV-1a, hex encoded
+  hash(text) {
+    let hash = 0x811c9dc5;
+    for (let i = 0; i < text.length; i++) {
+      hash ^= text.charCodeAt(i);
+      hash = Math.imul(hash, 0x01000193);
+    }
+    return (hash >>> 0).toString(16).padStart(8, '0');
+  },
+
+  // Parse routes from OpenAPI paths
+  parseRoutes(spec) {
+    const routes = [];
+
+    if (!spec.paths) return routes;
+
+    const examples = MakerAPISchemaEngine.forSpec(spec);
+
+    for (const [path, pathItem] of Object.entries(spec.paths)) {
+      for (const [method, operation] of Object.entries(pathItem)) {
+        if (!operation || typeof operation !== 'object') continue;
+
+        // Extract authentication types - support multiple auth types
+        let authTypes = ['none'];
+        if (operation.security && operation.security.length > 0) {
+          authTypes = [];
+          operation.security.forEach(security => {
+            if (security.bearerAuth) {
+              authTypes.push('token');
+            }
+            if (security.cookieAuth) {
+              authTypes.push('session');
+            }
+            if (security.pageTokenAuth) {
+              authTypes.push('page_token');
+            }
+            if (security.localAuth) {
+              authTypes.push('local_only');
+            }
+          });
+          // If no recognized auth types found, default to 'none'
+          if (authTypes.length === 0) {
+            authTypes = ['none'];
+          }
+        }
+
+        // Determine display auth type - use 'mixed' if multiple types
+        const authType = authTypes.length > 1 ? 'mixed' : authTypes[0];
+
+        // Extract module name from tags
+        let moduleName = 'Platform';
+        if (operation.tags && operation.tags.length > 0) {
+          moduleName = operation.tags[0];
+        }
+
+        const route = {
+          hash: this.hash(path + method + JSON.stringify(operation)),
+          path: path,
+          method: method.toUpperCase(),
+          summary: operation.summary || '',
+          description: operation.description || operation.summary || '',
+          authType: authType,
+          authTypes: authTypes, // Store all supported auth types
+          module: moduleName,
+          tags: operation.tags || [moduleName],
+          operationId: operation.operationId || '',
+          parameters: operation.parameters || [],
+          requestBody: !!operation.requestBody,
+          requestBodyTemplate: examples.requestBodyTemplate(operation.requestBody)
+        };
+
+        // Pre-built search text so filtering never walks the route fields
+        route.searchText = [
+          route.path,
+          route.method,
+          route.summary || route.description || '',
+          route.module || '',
+          route.tags.join(' ')
+        ].join(' ').toLowerCase();
+
+        routes.push(route);
+      }
+    }
+
+    return routes;
+  },
+
+  // Collect all unique tags (formatted) across routes, sorted
+  collectTags(routes) {
+    const allTags = new Set();
+
+    routes.forEach(route => {
+      if (route.tags && Array.isArray(route.tags)) {
+        route.tags.forEach(tag => {
+          if (tag && tag.trim()) {
+            allTags.add(this.formatModuleName(tag));
+          }
+        });
+      } else {
+        // Fallback to module name if no tags
+        allTags.add(this.formatModuleName(route.module || 'Platform'));
+      }
+    });
+
+    return Array.from(allTags).sort();
+  },
+
+  // Format module name (kept in sync with MakerAPI.formatModuleName)
+  formatModuleName(name) {
+    return name.replace(/[-_]/g, ' ').replace(/\b\w/g, l => l.toUpperCase());
+  }
+};
+
+// Generates request body examples from OpenAPI schemas. Resolves $ref
+// against the spec (components), handles nested objects, arrays, allOf and
+// oneOf/anyOf, stops at reference cycles, and memoizes per schema object and
+// per $ref so operations sharing schemas don't regenerate them.
+const MakerAPISchemaEngine = {
+  MAX_DEPTH: 8,
+
+  forSpec(spec) {
+    return Object.assign(Object.create(this), {
+      spec: spec,
+      memo: new WeakMap(),     // schema object -> example
+      refMemo: new Map(),      // $ref -> example
+      templateMemo: new WeakMap(), // requestBody object -> JSON template
+      cycles: 0                // bumped whenever a cycle cut an example short
+    });
+  },
+
+  // JSON template for an operation's requestBody, or null without a body
+  requestBodyTemplate(requestBody) {
+    if (!requestBody) return null;
+
+    if (this.templateMemo.has(requestBody)) {
+      return this.templateMemo.get(requestBody);
+    }
+
+    let template = null;
+    try {
+      const body = this.resolve(requestBody);
+      const jsonContent = body && body.content && body.content['application/json'];
+      if (jsonContent) {
+        // Use example if available, otherwise generate one from the schema
+        if (jsonContent.example !== undefined) {
+          template = JSON.stringify(jsonContent.example, null, 2);
+        } else if (jsonContent.schema) {
+          const example = this.example(jsonContent.schema);
+          if (example !== null && example !== undefined) {
+            template = JSON.stringify(example, null, 2);
+          }
+        }
+      }
+    } catch (error) {
+      console.warn('Failed to generate example from schema:', error);
+    }
+
+    this.templateMemo.set(requestBody, template);
+    return template;
+  },
+
+  // Follow a local $ref (e.g. #/components/schemas/Foo); other objects
+  // pass through
+  resolve(node) {
+    if (!node || typeof node.$ref !== 'string') return node;
+    if (!node.$ref.startsWith('#/')) return null;
+
+    return node.$ref.slice(2).split('/').reduce((target, segment) => {
+      const key = segment.replace(/~1/g, '/').replace(/~0/g, '~');
+      return target && typeof target === 'object' ? target[key] : undefined;
+    }, this.spec) || null;
+  },
+
+  example(schema, stack = []) {
+    if (!schema || typeof schema !== 'object') return null;
+
+    if (typeof schema.$ref === 'string') {
+      if (this.refMemo.has(schema.$ref)) return this.refMemo.get(schema.$ref);
+      if (stack.includes(schema.$ref) || stack.length >= this.MAX_DEPTH) {
+        this.cycles++;
+        return null;
+      }
+
+      const cyclesBefore = this.cycles;
+      const value = this.example(this.resolve(schema), stack.concat(schema.$ref));
+      // Results cut short by a cycle depend on where we came from - don't reuse
+      if (this.cycles === cyclesBefore) {
+        this.refMemo.set(schema.$ref, value);
+      }
+      return value;
+    }
+
+    if (this.memo.has(schema)) return this.memo.get(schema);
+
+    const cyclesBefore = this.cycles;
+    const value = this.generate(schema, stack);
+    if (this.cycles === cyclesBefore) {
+      this.memo.set(schema, value);
+    }
+    return value;
+  },
+
+  generate(schema, stack) {
+    // Explicit values in the schema win
+    if (schema.example !== undefined) return schema.example;
+    if (schema.default !== undefined) return schema.default;
+    if (schema.const !== undefined) return schema.const;
+    if (Array.isArray(schema.enum) && schema.enum.length > 0) return schema.enum[0];
+
+    if (Array.isArray(schema.allOf)) {
+      // Merge the object parts; a non-object part (rare) wins outright
+      let merged = {};
+      for (const part of schema.allOf) {
+        const value = this.example(part, stack);
+        if (value && typeof value === 'object' && !Array.isArray(value)) {
+          merged = Object.assign({}, merged, value);
+        } else if (value !== null) {
+          return value;
+        }
+      }
+      return merged;
+    }
+
+    const choices = schema.oneOf || schema.anyOf;
+    if (Array.isArray(choices)) {
+      for (const choice of choices) {
+        const value = this.example(choice, stack);
+        if (value !== null) return value;
+      }
+      return null;
+    }
+
+    const type = schema.type || (schema.properties ? 'object' : schema.items ? 'array' : undefined);
+
+    switch (type) {
+      case 'object': {
+        const example = {};
+        for (const [propName, propSchema] of Object.entries(schema.properties || {})) {
+          example[propName] = this.example(propSchema, stack);
+        }
+        return example;
+      }
+      case 'array': {
+        const item = this.example(schema.items, stack);
+        return item === null ? [] : [item];
+      }
+      case 'string':
+        return this.stringExample(schema);
+      case 'integer':
+        return 0;
+      case 'number':
+        return 0.0;
+      case 'boolean':
+        return false;
+      default:
+        return null;
+    }
+  },
+
+  stringExample(schema) {
+    const formats = {
+      'date-time': '2024-01-01T00:00:00Z',
+      'date': '2024-01-01',
+      'email': 'user@example.com',
+      'uuid': '00000000-0000-0000-0000-000000000000',
+      'uri': 'https://example.com',
+      'ipv4': '192.168.1.100'
+    };
+    if (schema.format && formats[schema.format]) {
+      return formats[schema.format];
+    }
+
+    // Use description as example if available
+    const description = schema.description;
+    if (!description) return 'string_value';
+
+    return description.includes('password') ? 'your_password_here' :
+           description.includes('username') ? 'your_username_here' :
+           description.includes('name') ? 'example_name' :
+           description.includes('token') ? 'your_token_name' :
+           'example_value';
+  }
+};
+
+// Worker entry point - requests are {id, url, since?}, replies are
+// {id, model|delta|error}. A request with `since` (a model version) is an
+// incremental refresh.
+if (typeof WorkerGlobalScope !== 'undefined' && self instanceof WorkerGlobalScope) {
+  self.onmessage = async (event) => {
+    const { id, url, since } = event.data || {};
+
+    try {
+      if (since) {
+        const result = await MakerAPISpecParser.refresh(url, since);
+        self.postMessage({ id, ...result });
+      } else {
+        const model = await MakerAPISpecParser.load(url);
+        self.postMessage({ id, model });
+      }
+    } catch (error) {
+      self.postMessage({ id, error: error.message });
+    }
+  };
+}
@@ -11,35 +11,57 @@ const MakerAPI = {
     error: null,
     token: null,
     availableTokens: [],
-    openApiSpec: null,
+    specInfo: null,  // Compact spec info ({title, version}) from the spec worker
+    specVersion: null,  // Hash of the rendered spec - base for incremental refresh
+    loadedSpec: null,  // Id of the spec the rendered routes came from
     allTags: null,  // Cache for all available tags
     openApiConfig: null,  // OpenAPI configuration from server
     selectedSpec: 'maker',  // Default to maker spec
-    availableSpecs: []  // List of available specs
+    availableSpecs: [],  // List of available specs
+    assetVersion: null,  // Asset fingerprint from /api/config (service worker version)
+    timeToInteractive: null,  // ms from navigation start to first render
+    metrics: null,  // Last /api/metrics response
+    loopTiming: null,  // Last /api/loop response
+    heap: null,  // Last /api/heap response
+    metricsRouteKeys: [],  // Route keys in rendered (sorted) row order
+    openMetricsCharts: new Set(),  // Route keys whose histogram row is expanded
+    metricsStream: null,  // EventSource for /api/metrics/stream
+    batchSelection: new Set(),  // Route ids selected for /api/batch
+    featureAssets: {},  // Optional feature name -> script path, from /api/config
+    features: new Set()  // Optional features whose script has loaded
+  },
+  
+  // Spec endpoints the server may advertise through /api/config
+  specDefinitions: {
+    full: {id: 'full', name: 'Full API Specification', url: '/openapi.json'},
+    maker: {id: 'maker', name: 'Maker API Specification', url: '/maker/openapi.json'}
   },
   
   // Initialize the dashboard
   async init() {
     this.setupUI();
     
-    // Initialize token UI first so it's usable even if other steps fail
-    this.updateTokenSelector();
-    
-    // Start token loading process - but don't await it directly
-    // This allows the UI to be responsive even if token loading fails
-    this.loadAvailableTokens().catch(error => {
-      console.warn('Token loading failed but continuing with app initialization:', error);
-    });
+    // Bootstrap pipeline: the config request and a speculative download of
+    // the default spec go out together, so the spec is usually parsed by the
+    // time the config confirms it is available.
+    const configReady = this.loadOpenApiConfiguration();
+    this.prefetchSpec(this.state.selectedSpec);
     
-    // Check OpenAPI configuration first
     try {
-      await this.loadOpenApiConfiguration();
+      await configReady;
+      
+      // Route cards render feature tabs and controls, so load the feature
+      // scripts first
+      await this.loadFeatures();
+      this.setupFeatures();
       
       // If no specs are available, show message and stop
       if (this.state.availableSpecs.length === 0) {
+        this.prefetchedSpec = null;
         this.showNoSpecsMessage();
         this.setupEventListeners();
         this.setupGlobalEventHandlers();
+        this.reportTimeToInteractive();
         return;
       }
       
@@ -58,6 +80,103 @@ const MakerAPI = {
     
     this.setupEventListeners();
     this.setupGlobalEventHandlers();
+    this.reportTimeToInteractive();
+    this.registerServiceWorker();
+    this.loadMetrics().then(() => this.subscribeMetrics());
+  },
+  
+  // Optional features call this from their script to add their methods
+  registerFeature(name, methods) {
+    Object.assign(this, methods);
+    this.state.features.add(name);
+  },
+  
+  hasFeature(name) {
+    return this.state.features.has(name);
+  },
+  
+  // Load the scripts of the optional features compiled into this build.
+  // A script that fails to load leaves its feature out rather than failing
+  // the dashboard.
+  loadFeatures() {
+    const modulePrefix = AuthUtils.getModulePrefix();
+    const version = this.state.assetVersion ? `?v=${this.state.assetVersion}` : '';
+    
+    return Promise.all(Object.entries(this.state.featureAssets).map(([name, path]) =>
+      new Promise(resolve => {
+        const script = document.createElement('script');
+        script.src = `${modulePrefix}${path}${version}`;
+        script.onload = resolve;
+        script.onerror = () => {
+          console.warn(`Failed to load dashboard feature: ${name}`);
+          resolve();
+        };
+        document.head.appendChild(script);
+      })));
+  },
+  
+  // Show and wire up the controls of features that loaded - hidden until then
+  setupFeatures() {
+    if (this.hasFeature('tokens')) {
+      this.setupTokenPicker();
+    }
+    if (this.hasFeature('batch')) {
+      this.setupBatch();
+    }
+  },
+  
+  // Register the module's service worker, scoped to the module prefix so it
+  // only ever controls this page. The asset fingerprint in the URL makes a
+  // firmware update install a fresh worker (and asset cache).
+  registerServiceWorker() {
+    if (!('serviceWorker' in navigator) || !this.state.assetVersion) return;
+    
+    const modulePrefix = AuthUtils.getModulePrefix();
+    navigator.serviceWorker
+      .register(`${modulePrefix}/maker-api-sw.js?v=${this.state.assetVersion}`, { scope: `${modulePrefix}/` })
+      .catch(error => console.warn('Service worker registration failed:', error));
+    
+    navigator.serviceWorker.addEventListener('message', (event) => {
+      const data = event.data || {};
+      if (data.type !== 'spec-updated') return;
+      
+      const selected = this.state.availableSpecs.find(spec => spec.id === this.state.selectedSpec);
+      if (selected && new URL(data.url).pathname === selected.url && this.state.specVersion) {
+        this.refreshRoutesIncrementally().catch(error => {
+          console.warn('Background spec refresh failed:', error);
+        });
+      }
+    });
+  },
+  
+  // Start downloading a spec before we know the server offers it. The result
+  // is only used if fetchSpecModel() asks for the same spec.
+  prefetchSpec(specId) {
+    const definition = this.specDefinitions[specId];
+    if (!definition) return;
+    
+    const promise = this.requestSpecModel(definition.url);
+    // Failures surface (and are retried) when the spec is actually requested
+    promise.catch(() => {});
+    this.prefetchedSpec = { id: specId, url: definition.url, promise };
+  },
+  
+  // Record time-to-interactive (from navigation start) for the console and
+  // the browser's performance panel
+  reportTimeToInteractive() {
+    if (typeof performance === 'undefined' || !performance.now) return;
+    
+    const tti = Math.round(performance.now());
+    this.state.timeToInteractive = tti;
+    
+    try {
+      performance.mark('makerapi-interactive');
+      performance.measure('makerapi-time-to-interactive', undefined, 'makerapi-interactive');
+    } catch (error) {
+      // User Timing is optional - the console report below is enough
+    }
+    
+    console.info(`Maker API dashboard interactive after ${tti}ms`);
   },
   
   // Load OpenAPI configuration from server
@@ -81,14 +200,20 @@ const MakerAPI = {
       
       const data = await response.json();
       this.state.openApiConfig = data.OpenApiConfig || {};
+      this.state.assetVersion = data.assetVersion || null;
+      this.state.featureAssets = data.features || {};
       
       // Determine available specs
       this.state.availableSpecs = [];
       if (this.state.openApiConfig.fullSpec) {
-        this.state.availableSpecs.push({id: 'full', name: 'Full API Specification', url: '/openapi.json'});
+        this.state.availableSpecs.push(this.specDefinitions.full);
       }
       if (this.state.openApiConfig.makerSpec) {
-        this.state.availableSpecs.push({id: 'maker', name: 'Maker API Specification', url: '/maker/openapi.json'});
+        // A spec baked into the firmware is served by this module instead
+        const makerSpecUrl = this.state.openApiConfig.makerSpecUrl;
+        this.state.availableSpecs.push(makerSpecUrl
+          ? {...this.specDefinitions.maker, url: `${modulePrefix}${makerSpecUrl}`}
+          : this.specDefinitions.maker);
       }
       
       // Set default selected spec
@@ -108,24 +233,284 @@ const MakerAPI = {
     }
   },
 
+  // Load per-route metrics and main loop timing from the device
+  async loadMetrics() {
+    const sections = [
+      { path: '/api/metrics', key: 'metrics', container: 'metrics-container', render: () => this.renderMetrics() },
+      { path: '/api/loop', key: 'loopTiming', container: 'loop-timing-container', render: () => this.renderLoopTiming() },
+      { path: '/api/heap', key: 'heap', container: 'heap-container', render: () => this.renderHeap() }
+    ];
+    
+    await Promise.all(sections.map(async section => {
+      const container = document.getElementById(section.container);
+      if (!container) return;
+      
+      try {
+        this.state[section.key] = await this.fetchModuleJson(section.path);
+        section.render();
+      } catch (error) {
+        console.warn(`Failed to load ${section.path}:`, error);
+        container.innerHTML = `<p class="error">❌ Failed to load: ${this.escapeHtml(error.message)}</p>`;
+      }
+    }));
+  },
+  
+  async fetchModuleJson(path) {
+    const modulePrefix = AuthUtils.getModulePrefix();
+    const response = await AuthUtils.fetch(`${modulePrefix}${path}`, {
+      method: 'GET',
+      headers: {
+        'Accept': 'application/json',
+        'X-Requested-With': 'XMLHttpRequest'
+      },
+      credentials: 'include'
+    });
+    
+    if (!response.ok) {
+      throw new Error(`HTTP ${response.status}`);
+    }
+    return response.json();
+  },
+  
+  formatBytes(value) {
+    return value >= 1024 ? `${(value / 1024).toFixed(1)}KB` : `${value}B`;
+  },
+  
+  // Render current heap stats and the sampled history as a line chart of
+  // free heap and largest free block
+  renderHeap() {
+    const container = document.getElementById('heap-container');
+    const heap = this.state.heap;
+    if (!container || !heap) return;
+    
+    const current = heap.current || {};
+    const kb = this.formatBytes;
+    const samples = heap.samples || [];
+    
+    container.innerHTML = `
+      <div class="load-test-stats">
+        <div><strong>free</strong> ${kb(current.freeBytes)}</div>
+        <div><strong>largest block</strong> ${kb(current.largestFreeBlock)}</div>
+        <div><strong>min free</strong> ${kb(current.minFreeBytes)}</div>
+        <div><strong>fragmentation</strong> ${current.fragmentationPercent}%</div>
+        ${current.psramTotalBytes ? `<div><strong>PSRAM free</strong> ${kb(current.psramFreeBytes)} / ${kb(current.psramTotalBytes)}</div>` : ''}
+      </div>
+      ${samples.length > 1 ? this.renderHeapChart(samples) : '<p>Collecting samples...</p>'}
+    `;
+  },
+  
+  // Samples are [uptimeSeconds, free, largest, minFree, psramFree]
+  renderHeapChart(samples) {
+    const width = 600;
+    const height = 120;
+    const start = samples[0][0];
+    const span = Math.max(1, samples[samples.length - 1][0] - start);
+    const peak = Math.max(1, ...samples.map(sample => sample[1]));
+    const line = column => samples.map(sample =>
+      `${((sample[0] - start) / span * width).toFixed(1)},${(height - sample[column] / peak * height).toFixed(1)}`
+    ).join(' ');
+    
+    return `
+      <svg class="heap-chart" viewBox="0 0 ${width} ${height}" preserveAspectRatio="none">
+        <polyline class="heap-line-free" points="${line(1)}" />
+        <polyline class="heap-line-largest" points="${line(2)}" />
+      </svg>
+      <div class="load-test-histogram-axis">
+        <span>${(span / 3600).toFixed(1)}h ago</span>
+        <span><span class="heap-legend-free">■</span> free <span class="heap-legend-largest">■</span> largest block</span>
+        <span>now</span>
+      </div>
+    `;
+  },
+  
+  // Render loop timing stats and the recent gaps as a time series; gaps over
+  // twice the mean period are highlighted
+  renderLoopTiming() {
+    const container = document.getElementById('loop-timing-container');
+    const loop = this.state.loopTiming;
+    if (!container || !loop) return;
+    
+    const us = this.formatMicros;
+    const samples = loop.samples || [];
+    const peak = Math.max(1, ...samples);
+    const longestAgo = (loop.uptimeMs - loop.longestGapAtMs) / 1000;
+    
+    container.innerHTML = `
+      <div class="load-test-stats">
+        <div><strong>period</strong> ${us(loop.periodUs)}</div>
+        <div><strong>jitter</strong> ${us(loop.jitterUs)}</div>
+        <div><strong>min</strong> ${us(loop.minUs)}</div>
+        <div><strong>max</strong> ${us(loop.maxUs)}</div>
+        <div><strong>longest</strong> ${us(loop.longestGapUs)}${loop.longestGapUs ? ` (${longestAgo.toFixed(0)}s ago)` : ''}</div>
+        <div><strong>iterations</strong> ${loop.iterations}</div>
+      </div>
+      ${samples.length ? `
+        <div class="load-test-histogram metrics-histogram">
+          ${samples.map(gap => `<div class="load-test-bar${gap > loop.periodUs * 2 ? ' loop-gap-slow' : ''}" style="height: ${(gap / peak) * 100}%" title="${us(gap)}"></div>`).join('')}
+        </div>
+        <div class="load-test-histogram-axis"><span>oldest</span><span>newest</span></div>
+      ` : ''}
+    `;
+  },
+  
+  // Render the metrics table, slowest routes (by average) first
+  renderMetrics() {
+    const container = document.getElementById('metrics-container');
+    const metrics = this.state.metrics;
+    if (!container || !metrics) return;
+    
+    const routes = (metrics.routes || []).slice().sort((a, b) => b.avgUs - a.avgUs);
+    if (routes.length === 0) {
+      container.innerHTML = '<p>No instrumented routes yet.</p>';
+      return;
+    }
+    
+    const us = this.formatMicros;
+    this.state.metricsRouteKeys = routes.map(route => this.metricsRouteKey(route));
+    const rows = routes.map((route, index) => `
+      <tr class="${route.count ? 'metrics-row' : ''}" ${route.count ? `onclick="MakerAPI.toggleMetricsChart(${index})"` : ''}>
+        <td>${this.escapeHtml(route.module)}</td>
+        <td><span class="api-method ${route.method.toLowerCase()}">${route.method}</span> ${this.escapeHtml(route.path)}</td>
+        <td>${route.count}</td>
+        <td>${route.count ? us(route.avgUs) : '-'}</td>
+        <td>${route.count ? us(route.p50Us) : '-'}</td>
+        <td>${route.count ? us(route.p90Us) : '-'}</td>
+        <td>${route.count ? us(route.p99Us) : '-'}</td>
+        <td>${route.count ? us(route.maxUs) : '-'}</td>
+        <td>${route.count ? route.heapDeltaAvg : '-'}</td>
+        <td>${route.count ? route.heapDeltaMax : '-'}</td>
+      </tr>
+      ${route.count ? `
+        <tr class="metrics-chart-row" id="metrics-chart-${index}" style="display: ${this.state.openMetricsCharts.has(this.state.metricsRouteKeys[index]) ? '' : 'none'};">
+          <td colspan="10">${this.renderBucketHistogram(route.histogram || [])}</td>
+        </tr>
+      ` : ''}
+    `).join('');
+    
+    container.innerHTML = `
+      <table class="metrics-table">
+        <thead>
+          <tr>
+            <th>Module</th><th>Route</th><th>Count</th><th>Avg</th><th>p50</th><th>p90</th><th>p99</th><th>Max</th>
+            <th title="Average free heap consumed per request (bytes)">Heap avg</th>
+            <th title="Largest free heap drop in a single request (bytes)">Heap max</th>
+          </tr>
+        </thead>
+        <tbody>${rows}</tbody>
+      </table>
+      ${metrics.dropped ? `<p class="error">⚠️ ${metrics.dropped} route(s) not instrumented - metrics table full (${metrics.capacity} slots)</p>` : ''}
+    `;
+  },
+  
+  formatMicros(value) {
+    return value >= 1000 ? `${(value / 1000).toFixed(1)}ms` : `${value}µs`;
+  },
+  
+  toggleMetricsChart(index) {
+    const row = document.getElementById(`metrics-chart-${index}`);
+    if (!row) return;
+    
+    const key = this.state.metricsRouteKeys[index];
+    const open = row.style.display === 'none';
+    row.style.display = open ? '' : 'none';
+    if (open) {
+      this.state.openMetricsCharts.add(key);
+    } else {
+      this.state.openMetricsCharts.delete(key);
+    }
+  },
+  
+  metricsRouteKey(route) {
+    return `${route.module} ${route.method} ${route.path}`;
+  },
+  
+  // Metrics polling through EventSource. The platform can't hold a response
+  // open, so this is not a live stream: the device answers each request
+  // with one event holding what changed since the Last-Event-ID and a
+  // retry interval, and EventSource polls again after it - updates arrive
+  // at the device's configured rate with changes in between coalesced.
+  subscribeMetrics() {
+    if (typeof EventSource === 'undefined' || this.state.metricsStream) return;
+    
+    const modulePrefix = AuthUtils.getModulePrefix();
+    const stream = new EventSource(`${modulePrefix}/api/metrics/stream`, { withCredentials: true });
+    stream.onmessage = (event) => {
+      try {
+        this.applyMetricsDelta(JSON.parse(event.data));
+      } catch (error) {
+        console.warn('Bad metrics event:', error);
+      }
+    };
+    stream.onerror = () => {
+      // Errors fire on every reconnect; CLOSED means the browser gave up
+      // (auth or HTTP error) - the Refresh button still works
+      if (stream.readyState === EventSource.CLOSED) {
+        this.state.metricsStream = null;
+      }
+    };
+    this.state.metricsStream = stream;
+  },
+  
+  applyMetricsDelta(delta) {
+    const { metrics, loopTiming, heap } = this.state;
+    
+    if (metrics && delta.routes && delta.routes.length) {
+      const byKey = new Map((metrics.routes || []).map(route => [this.metricsRouteKey(route), route]));
+      delta.routes.forEach(route => byKey.set(this.metricsRouteKey(route), route));
+      metrics.routes = Array.from(byKey.values());
+      this.renderMetrics();
+    }
+    
+    if (loopTiming && delta.loop) {
+      Object.assign(loopTiming, delta.loop);
+      this.renderLoopTiming();
+    }
+    
+    if (heap && delta.heap) {
+      heap.current = delta.heap.current;
+      const samples = heap.samples || (heap.samples = []);
+      const newest = samples[samples.length - 1];
+      if (delta.heap.sample && (!newest || delta.heap.sample[0] > newest[0])) {
+        samples.push(delta.heap.sample);
+      }
+      this.renderHeap();
+    }
+  },
+  
+  // Chart a device latency histogram ([lowerUs, upperUs, count] buckets).
+  // Buckets are log-linear, so equal-width bars give a log time axis; empty
+  // buckets between the first and last are filled in to keep it continuous.
+  renderBucketHistogram(buckets) {
+    if (buckets.length === 0) return '';
+    
+    // The overflow bucket has no upper bound (null)
+    const bound = (bar) => bar.upper === null ? `${this.formatMicros(bar.lower)}+` : this.formatMicros(bar.upper);
+    const bars = [];
+    buckets.forEach(([lower, upper, count], i) => {
+      const previous = buckets[i - 1];
+      if (previous && previous[1] < lower) {
+        bars.push({ lower: previous[1], upper: lower, count: 0 });
+      }
+      bars.push({ lower, upper, count });
+    });
+    const peak = Math.max(...bars.map(bar => bar.count));
+    
+    return `
+      <div class="load-test-histogram metrics-histogram">
+        ${bars.map(bar => `<div class="load-test-bar" style="height: ${(bar.count / peak) * 100}%" title="${bar.upper === null ? bound(bar) : `${this.formatMicros(bar.lower)}-${bound(bar)}`}: ${bar.count}"></div>`).join('')}
+      </div>
+      <div class="load-test-histogram-axis"><span>${this.formatMicros(bars[0].lower)}</span><span>${bound(bars[bars.length - 1])}</span></div>
+    `;
+  },
+  
   // Load API routes from OpenAPI specification
   async loadRoutes() {
     this.showLoading(true);
     
     try {
-      // Fetch OpenAPI spec from the selected endpoint
-      this.state.openApiSpec = await this.fetchOpenAPISpec();
-      
-      // Parse routes from OpenAPI paths
-      this.state.routes = this.parseRoutesFromOpenAPI(this.state.openApiSpec);
-      this.state.error = null;
-      
-      this.updateStats();
-      this.renderRoutes();
-      this.showLoading(false);
-      
-      // Update server info with new spec data
-      this.updateServerInfo();
+      // Fetch and parse the selected spec off the main thread
+      const model = await this.fetchSpecModel();
+      this.applySpecModel(model);
             
     } catch (error) {
       console.error('Failed to load routes:', error);
@@ -134,64 +519,138 @@ const MakerAPI = {
     }
   },
   
-
-
-  // Parse routes from OpenAPI specification
-  parseRoutesFromOpenAPI(spec) {
-    const routes = [];
+  // Replace the route model and render it from scratch
+  applySpecModel(model) {
+    this.state.specInfo = model.info;
+    this.state.specVersion = model.version;
+    this.state.loadedSpec = this.state.selectedSpec;
+    this.state.routes = model.routes;
+    this.state.allTags = model.allTags;
+    this.state.error = null;
+    
+    this.updateStats();
+    this.renderRoutes();
+    this.showLoading(false);
     
-    if (!spec.paths) return routes;
+    // Update server info with new spec data
+    this.updateServerInfo();
+  },
+  
+  // Refresh the loaded spec in place: the spec worker diffs the current spec
+  // against the version we rendered and only changed operations are patched
+  // into the route model and DOM, so expanded cards and Try It inputs survive
+  async refreshRoutesIncrementally() {
+    const selected = this.state.availableSpecs.find(spec => spec.id === this.state.selectedSpec);
+    if (!selected) {
+      throw new Error('No selected specification available');
+    }
     
-    for (const [path, pathItem] of Object.entries(spec.paths)) {
-      for (const [method, operation] of Object.entries(pathItem)) {
-        if (!operation || typeof operation !== 'object') continue;
-        
-        // Extract authentication types - support multiple auth types
-        let authTypes = ['none'];
-        if (operation.security && operation.security.length > 0) {
-          authTypes = [];
-          operation.security.forEach(security => {
-            if (security.bearerAuth) {
-              authTypes.push('token');
-            }
-            if (security.cookieAuth) {
-              authTypes.push('session');
-            }
-            if (security.localAuth) {
-              authTypes.push('local_only');
-            }
-          });
-          // If no recognized auth types found, default to 'none'
-          if (authTypes.length === 0) {
-            authTypes = ['none'];
-          }
-        }
-        
-        // Determine display auth type - use 'mixed' if multiple types
-        let authType = authTypes.length > 1 ? 'mixed' : authTypes[0];
-        
-        // Extract module name from tags
-        let moduleName = 'Platform';
-        if (operation.tags && operation.tags.length > 0) {
-          moduleName = operation.tags[0];
-        }
-        
-        routes.push({
-          path: path,
-          method: method.toUpperCase(),
-          summary: operation.summary || '',
-          description: operation.description || operation.summary || '',
-          authType: authType,
-          authTypes: authTypes, // Store all supported auth types
-          module: moduleName,
-          tags: operation.tags || [moduleName],
-          operationId: operation.operationId || '',
-          parameters: operation.parameters || []
-        });
-      }
+    const result = await this.postSpecRequest({ url: selected.url, since: this.state.specVersion });
+    
+    // The worker no longer holds our version (e.g. it was restarted)
+    if (result.model) {
+      this.applySpecModel(result.model);
+      return;
+    }
+    
+    this.applySpecDelta(result.delta);
+  },
+  
+  // Apply a {version, added, changed, removed} delta from the spec worker
+  applySpecDelta(delta) {
+    this.state.specVersion = delta.version;
+    
+    const changes = delta.added.length + delta.changed.length + delta.removed.length;
+    if (changes === 0) {
+      this.showToast('Routes are up to date', 'info');
+      return;
+    }
+    
+    if (delta.info) this.state.specInfo = delta.info;
+    if (delta.allTags) this.state.allTags = delta.allTags;
+    
+    const removed = new Set(delta.removed.map(route => this.generateRouteId(route)));
+    const changed = new Map(delta.changed.map(route => [this.generateRouteId(route), route]));
+    
+    this.state.routes = this.state.routes
+      .filter(route => !removed.has(this.generateRouteId(route)))
+      .map(route => changed.get(this.generateRouteId(route)) || route)
+      .concat(delta.added);
+    
+    this.updateStats();
+    this.updateTagFilter();
+    this.updateServerInfo();
+    
+    // Filtered views are cheap to rebuild and would need the same filter
+    // logic to patch, so only the unfiltered view is patched in place
+    if (this.hasActiveFilters()) {
+      this.applyFilters();
+    } else {
+      this.patchRouteCards(delta);
+    }
+    
+    this.showToast(`Routes updated: ${delta.added.length} added, ${delta.changed.length} changed, ${delta.removed.length} removed`, 'success');
+  },
+  
+  // Patch route cards for a delta without touching unchanged cards
+  patchRouteCards(delta) {
+    const container = document.getElementById('routes-container');
+    if (!container || !container.querySelector('.api-section') || this.state.routes.length === 0) {
+      this.renderRoutes();
+      return;
     }
     
-    return routes;
+    delta.removed.forEach(route => {
+      const card = container.querySelector(`[data-route-id="${this.generateRouteId(route)}"]`);
+      if (card) card.remove();
+    });
+    
+    delta.changed.forEach(route => {
+      const routeId = this.generateRouteId(route);
+      const card = container.querySelector(`[data-route-id="${routeId}"]`);
+      if (!card) return;
+      
+      const wasExpanded = card.classList.contains('expanded');
+      const activeTab = card.querySelector('.endpoint-tab-button.active');
+      const tabId = activeTab ? activeTab.dataset.tab : 'try';
+      
+      card.insertAdjacentHTML('afterend', this.renderRouteCard(route));
+      card.remove();
+      
+      if (wasExpanded) {
+        container.querySelector(`[data-route-id="${routeId}"]`).classList.add('expanded');
+        this.switchEndpointTab(routeId, tabId);
+      }
+    });
+    
+    delta.added.forEach(route => {
+      const module = this.formatModuleName(route.module || 'Platform');
+      const section = container.querySelector(`[data-section="${this.getSectionId(module)}"]`);
+      if (section) {
+        section.querySelector('.api-section-content').insertAdjacentHTML('beforeend', this.renderRouteCard(route));
+      } else {
+        container.insertAdjacentHTML('beforeend', this.renderModuleSection(module, [route]));
+      }
+    });
+    
+    // Refresh section counts and drop sections that lost all their routes
+    container.querySelectorAll('.api-section').forEach(section => {
+      const count = section.querySelectorAll('.api-endpoint').length;
+      if (count === 0) {
+        section.remove();
+        return;
+      }
+      const countEl = section.querySelector('.route-count');
+      if (countEl) countEl.textContent = `(${count})`;
+    });
+  },
+  
+  // Whether any search/tag/method filter is currently applied
+  hasActiveFilters() {
+    return ['route-search', 'tag-filter', 'method-filter'].some(id => {
+      const el = document.getElementById(id);
+      return el && el.value;
+    });
   },
   
   // Render routes in the UI
@@ -267,6 +726,7 @@ const MakerAPI = {
     return `
       <div class="api-endpoint" data-method="${route.method.toLowerCase()}" data-auth="${authType}" data-route-id="${routeId}">
         <div class="api-endpoint-header" onclick="MakerAPI.toggleEndpoint('${routeId}')">
+          ${this.hasFeature('batch') ? this.renderBatchCheckbox(route, routeId) : ''}
           <span class="api-method ${route.method.toLowerCase()}">${route.method.toUpperCase()}</span>
           <span class="api-path" data-full-path="${this.escapeHtml(route.path)}" title="${this.escapeHtml(route.path)}">${this.escapeHtml(route.path)}</span>
           <span class="api-description">${this.escapeHtml(route.summary || route.description || 'No description available')}</span>
@@ -297,6 +757,7 @@ const MakerAPI = {
     const icons = {
       'none': '🌍',
       'session': '🔒',
+      'page_token': '📄',
       'token': '🔑',
       'local_only': '🏠',
       'mixed': '🔐'
@@ -309,6 +770,7 @@ const MakerAPI = {
     const labels = {
       'none': 'Public',
       'session': 'Session',
+      'page_token': 'Page Token',
       'token': 'Token',
       'local_only': 'Local Only',
       'mixed': 'Mixed'
@@ -379,12 +841,15 @@ const MakerAPI = {
       downloadBtn.addEventListener('click', () => this.downloadOpenAPISpec());
     }
     
-    // Token management
-    const tokenSelector = document.getElementById('token-selector');
-    const tokenInput = document.getElementById('api-token-input');
+    // Route metrics
+    const metricsBtn = document.getElementById('refresh-metrics');
+    if (metricsBtn) {
+      metricsBtn.addEventListener('click', () => this.loadMetrics());
+    }
     
-    if (tokenSelector) {
-      tokenSelector.addEventListener('change', (e) => this.onTokenSelectionChange(e));
+    const traceBtn = document.getElementById('download-trace');
+    if (traceBtn) {
+      traceBtn.addEventListener('click', () => this.downloadTrace());
     }
     
     // Filters
@@ -466,16 +931,8 @@ const MakerAPI = {
     let filtered = this.state.routes.filter(route => {
       // Search filter
       if (searchTerm) {
-        const searchText = [
-          route.path,
-          route.method,
-          route.summary || route.description || '',
-          route.module || '',
-          route.name || '',
-          (route.tags || []).join(' ')
-        ].join(' ').toLowerCase();
-        
-        if (!searchText.includes(searchTerm)) return false;
+        // searchText is pre-built by the spec worker
+        if (!route.searchText.includes(searchTerm)) return false;
       }
       
       // Tag filter - check if selected tag appears anywhere in route's tags
@@ -550,8 +1007,13 @@ const MakerAPI = {
         }
       }
       
-      // Load routes with current/updated configuration
-      await this.loadRoutes();
+      // Patch the loaded spec in place when it is still the selected one,
+      // otherwise load the (new) selection from scratch
+      if (this.state.specVersion && this.state.loadedSpec === this.state.selectedSpec) {
+        await this.refreshRoutesIncrementally();
+      } else {
+        await this.loadRoutes();
+      }
       
     } catch (error) {
       console.error('Failed to refresh:', error);
@@ -677,9 +1139,9 @@ const MakerAPI = {
     const specVersionEl = document.getElementById('spec-version');
     if (!specVersionEl) return;
     
-    if (this.state.openApiSpec && this.state.openApiSpec.info) {
-      const version = this.state.openApiSpec.info.version || 'Unknown';
-      const title = this.state.openApiSpec.info.title || 'API';
+    if (this.state.specInfo) {
+      const version = this.state.specInfo.version || 'Unknown';
+      const title = this.state.specInfo.title || 'API';
       specVersionEl.textContent = `${title} v${version}`;
     } else {
       specVersionEl.textContent = 'Loading...';
@@ -748,6 +1210,38 @@ const MakerAPI = {
   },
 
   // Download OpenAPI specification
+  // Save the device's request trace for Perfetto / chrome://tracing
+  async downloadTrace() {
+    try {
+      const trace = await this.fetchModuleJson('/api/trace');
+      const info = trace.otherData || {};
+      if (!info.enabled && (trace.traceEvents || []).length === 0) {
+        this.showToast('Request tracing is disabled on the device', 'error');
+        return;
+      }
+      
+      const blob = new Blob([JSON.stringify(trace)], { type: 'application/json' });
+      const url = URL.createObjectURL(blob);
+      
+      const link = document.createElement('a');
+      link.href = url;
+      link.download = 'maker-api-trace.json';
+      document.body.appendChild(link);
+      link.click();
+      
+      setTimeout(() => {
+        document.body.removeChild(link);
+        URL.revokeObjectURL(url);
+      }, 100);
+      
+      this.showToast('Request trace downloaded', 'success');
+      
+    } catch (error) {
+      console.error('Trace download failed:', error);
+      this.showToast('Failed to download request trace', 'error');
+    }
+  },
+
   async downloadOpenAPISpec() {
     try {
       const selectedSpecInfo = this.state.availableSpecs.find(spec => spec.id === this.state.selectedSpec);
@@ -782,165 +1276,6 @@ const MakerAPI = {
     }
   },
   
-  // Load available tokens for the current user
-  async loadAvailableTokens() {
-    try {
-      // Always make sure the selector is initialized first, so UI works regardless
-      this.state.availableTokens = [];
-      this.updateTokenSelector();
-      
-      // Try to get the user's tokens if we're logged in
-      try {
-        // First check if we're logged in by getting current user
-        const userResponse = await fetch('/api/user', {
-          method: 'GET',
-          headers: {
-            'Accept': 'application/json',
-            'X-Requested-With': 'XMLHttpRequest'
-          },
-          credentials: 'include'
-        });
-        
-        if (!userResponse.ok) {
-          return;
-        }
-        
-        // Parse the user data - the ID might be in different locations depending on API structure
-        const userData = await userResponse.json();
-        let userId = null;
-        
-        // Look for ID in different possible locations
-        if (userData.id) {
-          userId = userData.id;
-        } else if (userData.user && userData.user.id) {
-          userId = userData.user.id;
-        } else if (userData.data && userData.data.id) {
-          userId = userData.data.id;
-        }
-        
-        // Try to use the userData object directly if we couldn't find an ID
-        if (!userId && userData) {
-          
-          // Try the /api/tokens endpoint first as fallback
-          const tokensResponse = await fetch('/api/tokens', {
-            method: 'GET',
-            headers: {
-              'Accept': 'application/json',
-              'X-Requested-With': 'XMLHttpRequest'
-            },
-            credentials: 'include'
-          });
-          
-          if (tokensResponse.ok) {
-            const tokensData = await tokensResponse.json();
-            if (tokensData.tokens && tokensData.tokens.length > 0) {
-              this.state.availableTokens = tokensData.tokens;
-              this.updateTokenSelector();
-              return;
-            }
-          }
-          
-          return;
-        }
-        
-        
-        // Now fetch tokens for this user
-        const tokensResponse = await fetch(`/api/users/${userId}/tokens`, {
-          method: 'GET',
-          headers: {
-            'Accept': 'application/json',
-            'X-Requested-With': 'XMLHttpRequest'
-          },
-          credentials: 'include'
-        });
-        
-        if (tokensResponse.ok) {
-          const tokensData = await tokensResponse.json();
-          this.state.availableTokens = tokensData.tokens || [];
-          this.updateTokenSelector();
-        } else {
-          console.warn(`Failed to load tokens: ${tokensResponse.status} ${tokensResponse.statusText}`);
-        }
-      } catch (innerError) {
-        console.warn('Error while trying to load tokens:', innerError);
-      }
-    } catch (error) {
-      console.warn('Failed to load available tokens (outer error):', error);
-    }
-  },
-  
-  // Update the token selector dropdown
-  updateTokenSelector() {
-    const tokenSelector = document.getElementById('token-selector');
-    const tokenInput = document.getElementById('api-token-input');
-    
-    if (!tokenSelector) return;
-    
-    // Clear existing options
-    tokenSelector.innerHTML = '<option value="manual">Enter token manually</option>';
-    
-    // Add existing tokens
-    if (this.state.availableTokens && this.state.availableTokens.length > 0) {
-      this.state.availableTokens.forEach(token => {
-        const option = document.createElement('option');
-        option.value = token.value || token.token;  // Handle different API formats
-        option.textContent = `🔑 ${token.name}${token.description ? ` - ${token.description}` : ''}`;
-        tokenSelector.appendChild(option);
-      });
-    }
-    
-    // Set default to manual entry
-    tokenSelector.value = 'manual';
-    
-    // Initial state setup
-    if (tokenInput) {
-      tokenInput.disabled = false;
-      tokenInput.placeholder = 'Enter your API token here...';
-    }
-    
-    // Update CSS to properly format the token section
-    this.updateTokenSectionStyles();
-  },
-  
-  // Update token section - styles now handled in CSS file
-  updateTokenSectionStyles() {
-    // Token section styling is now handled in maker_api_styles_css.h
-    // This function remains for any future dynamic styling needs
-  },
-  
-  // Handle token selection change
-  onTokenSelectionChange(event) {
-    const tokenInput = document.getElementById('api-token-input');
-    if (!tokenInput) return;
-    
-    const selectedValue = event.target.value;
-    
-    if (selectedValue === 'manual') {
-      // Enable manual entry
-      tokenInput.disabled = false;
-      tokenInput.value = '';
-      tokenInput.placeholder = 'Enter your API token here...';
-      this.state.token = null;
-      this.showToast('Enter your token manually', 'info');
-    } else {
-      // Use selected token
-      tokenInput.disabled = true;
-      tokenInput.value = selectedValue;
-      tokenInput.placeholder = '';
-      this.state.token = selectedValue;
-      
-      // Find the token name from our list
-      const selectedToken = this.state.availableTokens.find(t => 
-        (t.value && t.value === selectedValue) || (t.token && t.token === selectedValue)
-      );
-      const tokenName = selectedToken ? selectedToken.name : 'Selected token';
-      
-      this.showToast(`Using token: ${tokenName}`, 'success');
-    }
-  },
-  
-
-  
   // Create parameter input field
   createParameterInput(param) {
     if (!param || !param.name) {
@@ -1050,7 +1385,7 @@ const MakerAPI = {
     });
     
     // If switching to cURL tab, immediately generate the command
-    if (tabId === 'curl') {
+    if (tabId === 'curl' && this.hasFeature('codegen')) {
       // Force immediate generation
       this.generateCurlCommand(routeId);
     }
@@ -1059,14 +1394,16 @@ const MakerAPI = {
   // Render endpoint content with tabs
   renderEndpointContent(route) {
     const routeId = this.generateRouteId(route);
+    const codegen = this.hasFeature('codegen');
+    const routeControl = codegen && this.state.selectedSpec === 'full';
     
     return `
       <div class="endpoint-tabs">
         <div class="endpoint-tab-buttons">
           <button type="button" class="endpoint-tab-button active" data-tab="try" onclick="MakerAPI.switchEndpointTab('${routeId}', 'try')">🧪 Try It</button>
-          <button type="button" class="endpoint-tab-button" data-tab="curl" onclick="MakerAPI.switchEndpointTab('${routeId}', 'curl')">💻 cURL</button>
-          ${this.state.selectedSpec === 'full' ? `<button type="button" class="endpoint-tab-button" data-tab="disable" onclick="MakerAPI.switchEndpointTab('${routeId}', 'disable')">🚫 Disable</button>` : ''}
-          ${this.state.selectedSpec === 'full' ? `<button type="button" class="endpoint-tab-button" data-tab="override" onclick="MakerAPI.switchEndpointTab('${routeId}', 'override')">🔄 Override</button>` : ''}
+          ${codegen ? `<button type="button" class="endpoint-tab-button" data-tab="curl" onclick="MakerAPI.switchEndpointTab('${routeId}', 'curl')">💻 cURL</button>` : ''}
+          ${routeControl ? `<button type="button" class="endpoint-tab-button" data-tab="disable" onclick="MakerAPI.switchEndpointTab('${routeId}', 'disable')">🚫 Disable</button>` : ''}
+          ${routeControl ? `<button type="button" class="endpoint-tab-button" data-tab="override" onclick="MakerAPI.switchEndpointTab('${routeId}', 'override')">🔄 Override</button>` : ''}
           <button type="button" class="endpoint-tab-button" data-tab="details" onclick="MakerAPI.switchEndpointTab('${routeId}', 'details')">📋 Details</button>
         </div>
         
@@ -1075,15 +1412,15 @@ const MakerAPI = {
             ${this.renderTryItTab(route, routeId)}
           </div>
           
-          <div class="endpoint-tab-panel" id="${routeId}-curl-tab">
+          ${codegen ? `<div class="endpoint-tab-panel" id="${routeId}-curl-tab">
             ${this.renderCurlTab(route, routeId)}
-          </div>
+          </div>` : ''}
           
-          ${this.state.selectedSpec === 'full' ? `<div class="endpoint-tab-panel" id="${routeId}-disable-tab">
+          ${routeControl ? `<div class="endpoint-tab-panel" id="${routeId}-disable-tab">
             ${this.renderDisableTab(route)}
           </div>` : ''}
           
-          ${this.state.selectedSpec === 'full' ? `<div class="endpoint-tab-panel" id="${routeId}-override-tab">
+          ${routeControl ? `<div class="endpoint-tab-panel" id="${routeId}-override-tab">
             ${this.renderOverrideTab(route)}
           </div>` : ''}
           
@@ -1116,6 +1453,9 @@ const MakerAPI = {
           case 'session':
             description = ' (Current Login)';
             break;
+          case 'page_token':
+            description = ' (This Page)';
+            break;
           case 'token':
             description = ' (API Token from token section)';
             break;
@@ -1175,6 +1515,9 @@ const MakerAPI = {
         
         <div class="endpoint-test-actions">
           <button type="button" class="btn btn-primary endpoint-execute-btn" onclick="MakerAPI.executeEndpointTest('${routeId}', MakerAPI.getRouteById('${routeId}'))">Try It!</button>
+          ${this.hasFeature('load-test') && !hasRequestBody && (!parameters || parameters.length === 0) ? `
+            <button type="button" class="btn btn-secondary" id="${routeId}-bench-btn" onclick="MakerAPI.runDeviceBenchmark('${routeId}')" title="Run the handler on the device without the network">⏱️ Benchmark on device</button>
+          ` : ''}
         </div>
         
         <div class="endpoint-test-results" id="${routeId}-results">
@@ -1182,54 +1525,18 @@ const MakerAPI = {
           <div class="response-status" id="${routeId}-status"></div>
           <div class="response-body" id="${routeId}-body"></div>
         </div>
+        
+        ${this.hasFeature('load-test') ? `
+        <div class="load-test-results" id="${routeId}-bench-results"></div>
+        
+        ${this.renderLoadTestSection(routeId)}
+        ` : ''}
       </div>
     `;
   },
   
-  // Render Disable tab
-  renderDisableTab(route) {
-    const disableCode = `// This will disable ${route.path} by deregistering it\nwebPlatform.registerApiRoute("${route.path.replace('/api','')}", nullptr);`;
-    const escapedCode = this.escapeHtml(disableCode);
-    
-    return `
-      <h4>Disable This Route</h4>
-      <p>Completely disables this route by deregistering it - returns 404</p>
-      <p><strong>Usage:</strong> Add this line in your setup() function after webPlatform.begin() and any registerModule calls.</p>
-      
-      <div class="code-section">
-        <div class="code-header">
-          <button type="button" class="btn btn-small btn-primary copy-code-btn" data-code="${escapedCode}" onclick="MakerAPI.copyCode(this.dataset.code)">
-            📋 Copy Code
-          </button>
-        </div>
-        <pre class="code-block"><code>${escapedCode}</code></pre>
-      </div>
-    `;
-  },
-  
-  // Render Override tab
-  renderOverrideTab(route) {
-    const overrideCode = `// Override route: ${route.method.toUpperCase()} ${route.path}\nwebPlatform.registerApiRoute("${route.path.replace('/api','')}", customHandler, {AuthType::NONE});\n\n// Implement your custom handler:\nvoid customHandler(WebRequest& req, WebResponse& res) {\n  res.setContent("Custom response", "text/plain");\n}`;
-    const escapedCode = this.escapeHtml(overrideCode);
-    
-    return `
-      <h4>Override This Route</h4>
-      <p>Replaces route with custom handler by re-registering it</p>
-      <p><strong>Usage:</strong> Add this line and implement your custom handler function after webPlatform.begin() and any registerModule calls.</p>
-      
-      <div class="code-section">
-        <div class="code-header">
-          <button type="button" class="btn btn-small btn-primary copy-code-btn" data-code="${escapedCode}" onclick="MakerAPI.copyCode(this.dataset.code)">
-            📋 Copy Code
-          </button>
-        </div>
-        <pre class="code-block"><code>${escapedCode}</code></pre>
-      </div>
-    `;
-  },
-  
-  // Render Details tab
-  renderDetailsTab(route) {
+  // Render Details tab
+  renderDetailsTab(route) {
     return `
       <h4>Route Information</h4>
       <div class="route-details">
@@ -1245,29 +1552,9 @@ const MakerAPI = {
     `;
   },
   
-  // Get route parameters from OpenAPI spec
+  // Get route parameters from the route model
   getRouteParameters(route) {
-    // Try to get parameters from route object first
-    if (route.parameters && Array.isArray(route.parameters)) {
-      return route.parameters;
-    }
-    
-    // Fall back to looking in OpenAPI spec
-    if (!this.state.openApiSpec || !this.state.openApiSpec.paths) {
-      return [];
-    }
-    
-    const pathInfo = this.state.openApiSpec.paths[route.path];
-    if (!pathInfo) {
-      return [];
-    }
-    
-    const methodInfo = pathInfo[route.method.toLowerCase()];
-    if (!methodInfo) {
-      return [];
-    }
-    
-    return methodInfo.parameters || [];
+    return Array.isArray(route.parameters) ? route.parameters : [];
   },
   
   // Check if route has request body (POST/PUT/PATCH methods with body)
@@ -1276,96 +1563,152 @@ const MakerAPI = {
     return ['POST', 'PUT', 'PATCH'].includes(method) && this.getRequestBodyFromSpec(route);
   },
   
-  // Get request body template from OpenAPI spec
+  // Get request body template - generated (and memoized per schema) by the
+  // spec worker's schema engine
   getRequestBodyTemplate(route) {
-    const requestBody = this.getRequestBodyFromSpec(route);
-    if (!requestBody) {
+    if (!this.getRequestBodyFromSpec(route)) {
       return '';
     }
     
-    // Try to get example from the spec first
-    if (requestBody.content && requestBody.content['application/json']) {
-      const jsonContent = requestBody.content['application/json'];
-      
-      // Use example if available
-      if (jsonContent.example) {
-        return JSON.stringify(jsonContent.example, null, 2);
-      }
-      
-      // Try to generate example from schema
-      if (jsonContent.schema) {
-        const example = this.generateExampleFromSchema(jsonContent.schema);
-        if (example) {
-          return JSON.stringify(example, null, 2);
-        }
-      }
-    }
-    
     // Default empty JSON object
-    return '{\n  \n}';
+    return route.requestBodyTemplate || '{\n  \n}';
   },
   
-  // Get request body from OpenAPI spec
+  // Whether the route model says the operation takes a request body
   getRequestBodyFromSpec(route) {
-    if (!this.state.openApiSpec || !this.state.openApiSpec.paths) {
-      return null;
+    return route.requestBody || null;
+  },
+  
+  // Collect the Try It inputs for a route into a ready-to-send request.
+  // Returns {url, options, requestBodyData} or {error} for an invalid body.
+  buildTestRequest(routeId, route) {
+    // Collect parameters from form
+    const form = document.getElementById(`${routeId}-form`);
+    const paramValues = {};
+    
+    if (form) {
+      const inputs = form.querySelectorAll('input, select');
+      inputs.forEach(input => {
+        if (input.value) {
+          let value = input.value;
+          if (input.type === 'number') {
+            value = parseFloat(value);
+          } else if (value === 'true') {
+            value = true;
+          } else if (value === 'false') {
+            value = false;
+          }
+          paramValues[input.name] = value;
+        }
+      });
     }
     
-    const pathInfo = this.state.openApiSpec.paths[route.path];
-    if (!pathInfo) {
-      return null;
+    // Get request body if present
+    let requestBodyData = null;
+    const bodyTextarea = document.getElementById(`${routeId}-body`);
+    if (bodyTextarea && bodyTextarea.value && bodyTextarea.value.trim) {
+      const bodyValue = bodyTextarea.value.trim();
+      if (bodyValue) {
+        try {
+          requestBodyData = JSON.parse(bodyValue);
+        } catch (error) {
+          return { error: `JSON Parse Error: ${error.message}` };
+        }
+      }
+    }
+          
+    // Get auth type - check if there's a selector for auth type choice
+    let authType = route.authType || route.auth || 'none';
+    const authSelector = document.getElementById(`${routeId}-auth-type`);
+    if (authSelector) {
+      // Use selected auth type from dropdown
+      authType = authSelector.value;
+    } else if (route.authTypes && route.authTypes.length === 1) {
+      // Use the single auth type if only one available
+      authType = route.authTypes[0];
     }
     
-    const methodInfo = pathInfo[route.method.toLowerCase()];
-    if (!methodInfo || !methodInfo.requestBody) {
-      return null;
+    // Create request options
+    const options = {
+      method: route.method.toUpperCase(),
+      // Set credentials to 'omit' when using token auth to prevent sending cookies
+      credentials: authType === 'token' ? 'omit' : 'include',
+      headers: {
+        'Accept': 'application/json',
+        'X-Requested-With': 'XMLHttpRequest'
+      }
+    };
+    
+    // Apply authentication based on type
+    if (authType === 'token') {
+      // Use token from the token section - even if empty
+      const tokenInput = document.getElementById('api-token-input');
+      const tokenValue = (tokenInput && tokenInput.value) ? tokenInput.value.trim() : '';
+      options.headers['Authorization'] = `Bearer ${tokenValue}`;
     }
     
-    return methodInfo.requestBody;
-  },
-  
-  // Generate example JSON from OpenAPI schema
-  generateExampleFromSchema(schema) {
-    if (!schema || typeof schema !== 'object') {
-      return null;
+    // Handle CSRF token for session-based and page token requests
+    if (authType === 'session' || authType === 'page_token') {
+      const csrfToken = document.querySelector('meta[name="csrf-token"]')?.getAttribute('content');
+      if (csrfToken) {
+        options.headers['X-CSRF-TOKEN'] = csrfToken;
+      }
     }
     
-    try {
-      if (schema.type === 'object' && schema.properties) {
-        const example = {};
+    // Build URL with path parameters replaced and query parameters
+    let url = route.path;
+    const usedParams = new Set();
+    
+    // First, replace path parameters (like {id})
+    Object.entries(paramValues).forEach(([key, value]) => {
+      const placeholder = `{${key}}`;
+      if (url.includes(placeholder)) {
+        url = url.replace(placeholder, encodeURIComponent(value));
+        usedParams.add(key);
+      }
+    });
+    
+    // Then add remaining parameters as query parameters for GET requests
+    if (route.method.toUpperCase() === 'GET') {
+      const queryParams = Object.entries(paramValues)
+        .filter(([key]) => !usedParams.has(key));
         
-        for (const [propName, propSchema] of Object.entries(schema.properties)) {
-          if (propSchema.type === 'string') {
-            // Use description as example if available
-            if (propSchema.description) {
-              example[propName] = propSchema.description.includes('password') ? 'your_password_here' :
-                                propSchema.description.includes('username') ? 'your_username_here' :
-                                propSchema.description.includes('name') ? 'example_name' :
-                                propSchema.description.includes('token') ? 'your_token_name' :
-                                'example_value';
-            } else {
-              example[propName] = 'string_value';
-            }
-          } else if (propSchema.type === 'integer') {
-            example[propName] = 0;
-          } else if (propSchema.type === 'number') {
-            example[propName] = 0.0;
-          } else if (propSchema.type === 'boolean') {
-            example[propName] = false;
-          } else if (propSchema.type === 'array') {
-            example[propName] = [];
-          } else {
-            example[propName] = null;
-          }
+      if (queryParams.length > 0) {
+        const queryString = queryParams
+          .map(([key, value]) => `${encodeURIComponent(key)}=${encodeURIComponent(value)}`)
+          .join('&');
+        url = `${url}${url.includes('?') ? '&' : '?'}${queryString}`;
+      }
+    }
+    
+    // Add request body for non-GET methods
+    if (route.method.toUpperCase() !== 'GET') {
+      let bodyToSend = null;
+      
+      // Prioritize manual request body from textarea
+      if (requestBodyData) {
+        bodyToSend = requestBodyData;
+      } else {
+        // Fallback to form parameters (excluding path parameters)
+        const bodyParams = Object.entries(paramValues)
+          .filter(([key]) => !usedParams.has(key))
+          .reduce((obj, [key, value]) => {
+            obj[key] = value;
+            return obj;
+          }, {});
+          
+        if (Object.keys(bodyParams).length > 0) {
+          bodyToSend = bodyParams;
         }
-        
-        return example;
       }
-    } catch (error) {
-      console.warn('Failed to generate example from schema:', error);
+      
+      if (bodyToSend) {
+        options.headers['Content-Type'] = 'application/json';
+        options.body = JSON.stringify(bodyToSend);
+      }
     }
     
-    return null;
+    return { url, options, requestBodyData };
   },
   
   // Execute endpoint test directly without proxy
@@ -1384,134 +1727,15 @@ const MakerAPI = {
       executeBtn.textContent = 'Executing...';
       executeBtn.disabled = true;
       
-      // Collect parameters from form
-      const form = document.getElementById(`${routeId}-form`);
-      const paramValues = {};
-      
-      if (form) {
-        const inputs = form.querySelectorAll('input, select');
-        inputs.forEach(input => {
-          if (input.value) {
-            let value = input.value;
-            if (input.type === 'number') {
-              value = parseFloat(value);
-            } else if (value === 'true') {
-              value = true;
-            } else if (value === 'false') {
-              value = false;
-            }
-            paramValues[input.name] = value;
-          }
-        });
-      }
-      
-      // Get request body if present
-      let requestBodyData = null;
-      const bodyTextarea = document.getElementById(`${routeId}-body`);
-      if (bodyTextarea && bodyTextarea.value && bodyTextarea.value.trim) {
-        const bodyValue = bodyTextarea.value.trim();
-        if (bodyValue) {
-          try {
-            requestBodyData = JSON.parse(bodyValue);
-          } catch (error) {
-            resultsEl.classList.add('show');
-            statusEl.innerHTML = '<span class="error">❌ Invalid JSON in request body</span>';
-            bodyEl.innerHTML = `<pre><code>JSON Parse Error: ${error.message}</code></pre>`;
-            return;
-          }
-        }
-      }
-            
-      // Get auth type - check if there's a selector for auth type choice
-      let authType = route.authType || route.auth || 'none';
-      const authSelector = document.getElementById(`${routeId}-auth-type`);
-      if (authSelector) {
-        // Use selected auth type from dropdown
-        authType = authSelector.value;
-      } else if (route.authTypes && route.authTypes.length === 1) {
-        // Use the single auth type if only one available
-        authType = route.authTypes[0];
-      }
-      
-      // Create request options
-      const options = {
-        method: route.method.toUpperCase(),
-        // Set credentials to 'omit' when using token auth to prevent sending cookies
-        credentials: authType === 'token' ? 'omit' : 'include',
-        headers: {
-          'Accept': 'application/json',
-          'X-Requested-With': 'XMLHttpRequest'
-        }
-      };
-      
-      // Apply authentication based on type
-      if (authType === 'token') {
-        // Use token from the token section - even if empty
-        const tokenInput = document.getElementById('api-token-input');
-        const tokenValue = (tokenInput && tokenInput.value) ? tokenInput.value.trim() : '';
-        options.headers['Authorization'] = `Bearer ${tokenValue}`;
-      }
-      
-      // Handle CSRF token for session-based requests
-      if (authType === 'session') {
-        const csrfToken = document.querySelector('meta[name="csrf-token"]')?.getAttribute('content');
-        if (csrfToken) {
-          options.headers['X-CSRF-TOKEN'] = csrfToken;
-        }
-      }
-      
-      // Build URL with path parameters replaced and query parameters
-      let url = route.path;
-      const usedParams = new Set();
-      
-      // First, replace path parameters (like {id})
-      Object.entries(paramValues).forEach(([key, value]) => {
-        const placeholder = `{${key}}`;
-        if (url.includes(placeholder)) {
-          url = url.replace(placeholder, encodeURIComponent(value));
-          usedParams.add(key);
-        }
-      });
-      
-      // Then add remaining parameters as query parameters for GET requests
-      if (route.method.toUpperCase() === 'GET') {
-        const queryParams = Object.entries(paramValues)
-          .filter(([key]) => !usedParams.has(key));
-          
-        if (queryParams.length > 0) {
-          const queryString = queryParams
-            .map(([key, value]) => `${encodeURIComponent(key)}=${encodeURIComponent(value)}`)
-            .join('&');
-          url = `${url}${url.includes('?') ? '&' : '?'}${queryString}`;
-        }
+      const built = this.buildTestRequest(routeId, route);
+      if (built.error) {
+        resultsEl.classList.add('show');
+        statusEl.innerHTML = '<span class="error">❌ Invalid JSON in request body</span>';
+        bodyEl.innerHTML = `<pre><code>${this.escapeHtml(built.error)}</code></pre>`;
+        return;
       }
       
-      // Add request body for non-GET methods
-      if (route.method.toUpperCase() !== 'GET') {
-        let bodyToSend = null;
-        
-        // Prioritize manual request body from textarea
-        if (requestBodyData) {
-          bodyToSend = requestBodyData;
-        } else {
-          // Fallback to form parameters (excluding path parameters)
-          const bodyParams = Object.entries(paramValues)
-            .filter(([key]) => !usedParams.has(key))
-            .reduce((obj, [key, value]) => {
-              obj[key] = value;
-              return obj;
-            }, {});
-            
-          if (Object.keys(bodyParams).length > 0) {
-            bodyToSend = bodyParams;
-          }
-        }
-        
-        if (bodyToSend) {
-          options.headers['Content-Type'] = 'application/json';
-          options.body = JSON.stringify(bodyToSend);
-        }
-      }
+      const { url, options, requestBodyData } = built;
       
       // Keep track of request details for display
       const requestDetails = {
@@ -1523,10 +1747,8 @@ const MakerAPI = {
       };
             
       // Execute direct request
-      const startTime = Date.now();
+      const startTime = performance.now();
       const response = await fetch(url, options);
-      const endTime = Date.now();
-      const duration = endTime - startTime;
       
       // Parse response
       let responseData;
@@ -1547,6 +1769,8 @@ const MakerAPI = {
           responseData = { text: responseText };
         }
       }
+      const duration = Math.round(performance.now() - startTime);
+      const timing = await this.getRequestTiming(url, startTime, response);
       
       // Format response headers
       const responseHeaders = {};
@@ -1582,6 +1806,7 @@ const MakerAPI = {
         <div class="response-details">
           <p><strong>Status:</strong> ${response.status} ${response.statusText}</p>
           <p><strong>Time:</strong> ${duration}ms</p>
+          ${this.renderTimingBreakdown(timing)}
           <p><strong>Headers:</strong></p>
           <pre><code>${JSON.stringify(responseHeaders, null, 2)}</code></pre>
           <p><strong>Body:</strong></p>
@@ -1600,422 +1825,209 @@ const MakerAPI = {
     }
   },
   
-  // Render cURL tab
-  renderCurlTab(route, routeId) {
-    const parameters = this.getRouteParameters(route);
-    const hasRequestBody = this.hasRequestBody(route);
-    const requestBodyTemplate = this.getRequestBodyTemplate(route);
-    
-    // Get authentication types - same logic as Try It tab
-    const authTypes = route.authTypes || [route.authType || route.auth || 'none'];
-    let authSelector = '';
-    
-    // Show auth selector if multiple auth types or if not 'none'
-    if (authTypes.length > 1 || (authTypes.length === 1 && authTypes[0] !== 'none')) {
-      const options = authTypes.map(authType => {
-        const label = this.getAuthLabel(authType);
-        const icon = this.getAuthIcon(authType);
-        let description = '';
-        
-        switch(authType) {
-          case 'session':
-            description = ' (Session Cookie)';
-            break;
-          case 'token':
-            description = ' (API Token)';
-            break;
-          case 'local_only':
-            description = ' (Local Network Only)';
-            break;
-          case 'none':
-            description = ' (No authentication)';
-            break;
-        }
-        
-        return `<option value="${authType}">${icon} ${label}${description}</option>`;
-      }).join('');
-      
-      authSelector = `
-        <div class="auth-selector">
-          <h4>🔧 Authentication Method for cURL</h4>
-          <select id="${routeId}-curl-auth-type" class="form-control" onchange="MakerAPI.generateCurlCommand('${routeId}')">
-            ${options}
-          </select>
+  // Break a completed request down into network phases (Resource Timing)
+  // and the device's own phases (Server-Timing)
+  async getRequestTiming(url, startTime, response) {
+    const absoluteUrl = new URL(url, window.location.href).href;
+    const findEntry = () => performance.getEntriesByName(absoluteUrl, 'resource')
+      .filter(entry => entry.startTime >= startTime - 1)
+      .pop();
+    
+    // The entry is queued when the body completes - give it a tick to land
+    let entry = findEntry();
+    if (!entry) {
+      await new Promise(resolve => setTimeout(resolve, 0));
+      entry = findEntry();
+    }
+    
+    // serverTiming is only populated in secure contexts - fall back to the header
+    const serverTiming = entry && entry.serverTiming && entry.serverTiming.length
+      ? entry.serverTiming.map(({ name, duration, description }) => ({ name, duration, description }))
+      : this.parseServerTiming(response.headers.get('server-timing'));
+    
+    if (!entry) {
+      return { phases: null, serverTiming };
+    }
+    
+    const span = (start, end) => (start > 0 && end >= start ? end - start : 0);
+    const tls = entry.secureConnectionStart > 0 ? span(entry.secureConnectionStart, entry.connectEnd) : 0;
+    
+    return {
+      phases: [
+        { name: 'Queueing', duration: span(entry.startTime, entry.domainLookupStart || entry.fetchStart) },
+        { name: 'DNS', duration: span(entry.domainLookupStart, entry.domainLookupEnd) },
+        { name: 'Connect', duration: span(entry.connectStart, entry.connectEnd) - tls },
+        { name: 'TLS', duration: tls },
+        { name: 'Waiting (TTFB)', duration: span(entry.requestStart, entry.responseStart) },
+        { name: 'Download', duration: span(entry.responseStart, entry.responseEnd) }
+      ],
+      total: entry.duration,
+      serverTiming
+    };
+  },
+  
+  // Parse a Server-Timing header: "handler;dur=1.2, serialize;desc=\"JSON\";dur=0.4"
+  parseServerTiming(header) {
+    if (!header) return [];
+    
+    return header.split(',').map(metric => {
+      const [name, ...params] = metric.split(';').map(part => part.trim());
+      const result = { name, duration: 0, description: '' };
+      params.forEach(param => {
+        const [key, value = ''] = param.split('=');
+        if (key === 'dur') result.duration = parseFloat(value) || 0;
+        if (key === 'desc') result.description = value.replace(/^"|"$/g, '');
+      });
+      return result;
+    }).filter(metric => metric.name);
+  },
+  
+  renderTimingBreakdown(timing) {
+    const ms = value => `${value.toFixed(2)}ms`;
+    let html = '';
+    
+    if (timing.phases) {
+      const scale = timing.total > 0 ? timing.total : 1;
+      html += `
+        <p><strong>Timing:</strong> ${ms(timing.total)}</p>
+        <div class="timing-breakdown">
+          ${timing.phases.map(phase => `
+            <div class="timing-row">
+              <span class="timing-label">${phase.name}</span>
+              <span class="timing-bar"><span style="width: ${Math.min(100, (phase.duration / scale) * 100)}%"></span></span>
+              <span class="timing-value">${ms(phase.duration)}</span>
+            </div>
+          `).join('')}
         </div>
       `;
     }
     
-    return `
-      <div class="endpoint-curl-section">
-        <h4>💻 cURL Command</h4>
-        <p>Configure parameters and authentication method. The cURL command updates automatically.</p>
-        
-        ${authSelector}
-        
-        ${parameters && parameters.length > 0 ? `
-        <div class="endpoint-parameter-section">
-          <h4>Parameters</h4>
-          <form id="${routeId}-curl-form">
-            ${parameters.map(param => this.createParameterInputForCurl(param, routeId)).join('')}
-          </form> 
-        </div>
-        ` : ''}
-        
-        <div class="endpoint-curl-actions">
-          <button type="button" class="btn btn-secondary" onclick="MakerAPI.copyCurlCommand('${routeId}')">📋 Copy to Clipboard</button>
-        </div>
-        
-        <div class="endpoint-test-results show" id="${routeId}-curl-results">
-          <h4>cURL Command</h4>
-          <div class="response-status" id="${routeId}-curl-status">
-            <span class="success">✅ cURL Command</span>
-          </div>
-          <div class="response-body" id="${routeId}-curl-output">
-            <pre><code>Generating cURL command...</code></pre>
-          </div>
+    if (timing.serverTiming.length > 0) {
+      html += `
+        <p><strong>Server-Timing:</strong></p>
+        <div class="timing-breakdown">
+          ${timing.serverTiming.map(metric => `
+            <div class="timing-row">
+              <span class="timing-label">${this.escapeHtml(metric.description || metric.name)}</span>
+              <span class="timing-value">${ms(metric.duration)}</span>
+            </div>
+          `).join('')}
         </div>
-        
-        <script>
-          setTimeout(function() { 
-            MakerAPI.generateCurlCommand('${routeId}'); 
-          }, 50);
-        </script>
-      </div>
-    `;
-  },
-  
-  // Create parameter input for cURL tab
-  createParameterInputForCurl(param, routeId) {
-    if (!param || !param.name) {
-      console.error('Invalid parameter object:', param);
-      return '<div class="parameter-input">Invalid parameter</div>';
-    }
-    
-    const required = param.required ? ' *' : '';
-    const type = param.schema && param.schema.type ? param.schema.type : 'string';
-    const paramName = this.escapeHtml(param.name);
-    const paramDesc = param.description ? this.escapeHtml(param.description) : '';
-    
-    let inputHtml = '';
-    switch (type) {
-      case 'boolean':
-        inputHtml = `
-          <select name="${paramName}" onchange="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''}>
-            <option value="">Select...</option>
-            <option value="true">true</option>
-            <option value="false">false</option>
-          </select>
-        `;
-        break;
-      case 'integer':
-      case 'number':
-        inputHtml = `<input type="number" name="${paramName}" oninput="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''} 
-                     placeholder="${paramDesc || paramName}">`;
-        break;
-      default:
-        inputHtml = `<input type="text" name="${paramName}" oninput="MakerAPI.generateCurlCommand('${routeId}')" ${param.required ? 'required' : ''} 
-                     placeholder="${paramDesc || paramName}">`;
-        break;
+      `;
     }
     
-    return `
-      <div class="parameter-input">
-        <label>
-          ${paramName}${required}
-          ${paramDesc ? `<span class="param-description">${paramDesc}</span>` : ''}
-        </label>
-        ${inputHtml}
-      </div>
-    `;
+    return html;
   },
   
-  // Generate cURL command for the cURL tab
-  generateCurlCommand(routeId) {
-    const route = this.getRouteById(routeId);
-    if (!route) {
-      console.error(`Route not found: ${routeId}`);
-      return;
-    }
-    
-    // Collect current parameter values from cURL form
-    const form = document.getElementById(`${routeId}-curl-form`);
-    const paramValues = {};
-    
-    if (form) {
-      const inputs = form.querySelectorAll('input, select');
-      inputs.forEach(input => {
-        if (input.value && input.value.trim) {
-          let value = input.value.trim();
-          if (value) {
-            if (input.type === 'number') {
-              value = parseFloat(value);
-            } else if (value === 'true') {
-              value = true;
-            } else if (value === 'false') {
-              value = false;
-            }
-            paramValues[input.name] = value;
-          }
-        }
-      });
+  // Fetch and parse the selected spec into a compact route model
+  async fetchSpecModel() {
+    const selectedSpecInfo = this.state.availableSpecs.find(spec => spec.id === this.state.selectedSpec);
+    if (!selectedSpecInfo) {
+      throw new Error('Failed to load API specification: No selected specification available');
     }
-  
-    // Build cURL command
-    let curl = `curl -X ${route.method.toUpperCase()}`;
-    
-    // Build URL with path parameters replaced
-    let urlPath = route.path;
-    const usedParams = new Set();
     
-    // Replace path parameters (like {id})
-    Object.entries(paramValues).forEach(([key, value]) => {
-      const placeholder = `{${key}}`;
-      if (urlPath.includes(placeholder)) {
-        urlPath = urlPath.replace(placeholder, encodeURIComponent(value));
-        usedParams.add(key);
-      }
-    });
-    
-    let url = `"${window.location.origin}${urlPath}"`;
-    
-    // Add remaining parameters as query parameters for GET requests
-    if (route.method.toUpperCase() === 'GET') {
-      const queryParams = Object.entries(paramValues)
-        .filter(([key]) => !usedParams.has(key));
-        
-      if (queryParams.length > 0) {
-        const queryString = queryParams
-          .map(([key, value]) => `${encodeURIComponent(key)}=${encodeURIComponent(value)}`)
-          .join('&');
-        url = `"${window.location.origin}${urlPath}?${queryString}"`;
-      }
-    }
-    
-    curl += ` ${url}`;
-    
-    // Add headers based on auth type
-    let authType = route.authType || route.auth || 'none';
-    const authSelector = document.getElementById(`${routeId}-curl-auth-type`);
-    if (authSelector) {
-      authType = authSelector.value;
-    } else if (route.authTypes && route.authTypes.length === 1) {
-      authType = route.authTypes[0];
-    }
-    
-    if (authType === 'token') {
-      const tokenInput = document.getElementById('api-token-input');
-      const tokenValue = (tokenInput && tokenInput.value) ? tokenInput.value.trim() : '';
-      curl += ` \\\\\n  -H "Authorization: Bearer ${tokenValue}"`;
-      curl += `\n  # Note: This curl command will not send cookies, only the token header`;
-      if (!tokenValue) {
-        curl += `\n  # Note: Token is empty - select or enter token in "API Token" section above`;
-      }
-    } else if (authType === 'session') {
-      const csrfToken = document.querySelector('meta[name="csrf-token"]')?.getAttribute('content');
-      if (csrfToken) {
-        curl += ` \\\\\n  -H "X-CSRF-TOKEN: ${csrfToken}"`;
-        curl += ` \\\\\n  -H "X-Requested-With: XMLHttpRequest"`;
-        curl += ` \\\\\n  --cookie "your_session_cookie_here"`;
-        curl += `\n  # Note: You'll need to manually add your session cookie`;
+    // Use the speculative download from init() if it was for this spec
+    const prefetched = this.prefetchedSpec;
+    this.prefetchedSpec = null;
+    if (prefetched && prefetched.url === selectedSpecInfo.url) {
+      try {
+        return await prefetched.promise;
+      } catch (error) {
+        console.warn('Speculative spec download failed, retrying:', error);
       }
-    } else if (authType === 'local_only') {
-      curl += `\n  # Note: This endpoint is restricted to local network access`;
     }
     
-    // Add body for POST/PUT/PATCH
-    if (['POST', 'PUT', 'PATCH'].includes(route.method.toUpperCase())) {
-      let bodyToSend = null;
-      
-      // Check for manual request body first
-      const bodyTextarea = document.getElementById(`${routeId}-curl-body`);
-      if (bodyTextarea && bodyTextarea.value && bodyTextarea.value.trim) {
-        const bodyValue = bodyTextarea.value.trim();
-        if (bodyValue) {
-          try {
-            bodyToSend = JSON.parse(bodyValue);
-          } catch (error) {
-            // Show error but continue with raw text
-            curl += `\n  # Warning: Request body is not valid JSON`;
-            curl += ` \\\\\n  -H "Content-Type: application/json"`;
-            curl += ` \\\\\n  -d '${bodyValue}'`;
-            this.displayCurlCommand(routeId, curl, true);
-            return;
-          }
-        }
-      } else {
-        // Fallback to form parameters (excluding path parameters)
-        const bodyParams = Object.entries(paramValues)
-          .filter(([key]) => !usedParams.has(key))
-          .reduce((obj, [key, value]) => {
-            obj[key] = value;
-            return obj;
-          }, {});
-          
-        if (Object.keys(bodyParams).length > 0) {
-          bodyToSend = bodyParams;
-        }
-      }
-      
-      if (bodyToSend) {
-        curl += ` \\\\\n  -H "Content-Type: application/json"`;
-        curl += ` \\\\\n  -d '${JSON.stringify(bodyToSend)}'`;
-      }
+    try {
+      return await this.requestSpecModel(selectedSpecInfo.url);
+    } catch (error) {
+      console.error('Error fetching OpenAPI spec:', error);
+      throw new Error(`Failed to load API specification: ${error.message}`);
     }
-    
-    // Display the command
-    this.displayCurlCommand(routeId, curl);
   },
   
-  // Display cURL command in the results area
-  displayCurlCommand(routeId, curl, hasWarning = false) {
-    const outputEl = document.getElementById(`${routeId}-curl-output`);
-    const statusEl = document.getElementById(`${routeId}-curl-status`);
-    
-    if (!outputEl) {
-      console.error(`curl-output element not found for ${routeId}`);
-      return;
-    }
-    
-    if (!statusEl) {
-      console.error(`curl-status element not found for ${routeId}`);
-    }
-    
-    const statusClass = hasWarning ? 'warning' : 'success';
-    const statusIcon = hasWarning ? '⚠️' : '✅';
-    
-    // Update status if element exists
-    if (statusEl) {
-      statusEl.innerHTML = `<span class="${statusClass}">${statusIcon} cURL Command${hasWarning ? ' (with warnings)' : ''}</span>`;
-    }
-    
-    // Update command display
-    outputEl.innerHTML = `<pre><code>${this.escapeHtml(curl)}</code></pre>`;
-    
-    // Store the command for copying
-    this.currentCurlCommands = this.currentCurlCommands || {};
-    this.currentCurlCommands[routeId] = curl;
-    
+  // Hand a spec URL to the spec worker and resolve with its route model
+  requestSpecModel(url) {
+    return this.postSpecRequest({ url }).then(result => result.model);
   },
   
-  // Copy current cURL command to clipboard
-  copyCurlCommand(routeId) {
-    const curlCommand = this.currentCurlCommands && this.currentCurlCommands[routeId];
-    
-    if (!curlCommand) {
-      this.showToast('No cURL command available to copy.', 'warning');
-      return;
-    }
-    
-    navigator.clipboard.writeText(curlCommand).then(() => {
-      this.showToast('cURL command copied to clipboard', 'success');
-    }).catch(err => {
-      console.error('Copy failed:', err);
-      this.showToast('Failed to copy to clipboard', 'error');
-      
-      // Fallback for browsers that don't support clipboard API
-      const textarea = document.createElement('textarea');
-      textarea.value = curlCommand;
-      textarea.style.position = 'fixed';
-      textarea.style.opacity = '0';
-      document.body.appendChild(textarea);
-      textarea.select();
-      
-      try {
-        const successful = document.execCommand('copy');
-        if (successful) {
-          this.showToast('cURL command copied to clipboard (fallback method)', 'success');
-        } else {
-          this.showToast('Copy failed with fallback method', 'error');
-        }
-      } catch (err) {
-        console.error('Fallback copy failed:', err);
-        this.showToast('Failed to copy cURL command', 'error');
-      }
-      
-      document.body.removeChild(textarea);
+  // Send a {url, since?} request to the spec worker; resolves with
+  // {model} or, for refreshes, {delta}
+  postSpecRequest(message) {
+    const worker = this.getSpecWorker();
+    if (!worker) {
+      return this.runSpecParserOnMainThread(message);
+    }
+    
+    const id = ++this.specRequestSeq;
+    return new Promise((resolve, reject) => {
+      this.specRequests.set(id, { resolve, reject });
+      worker.postMessage({ id, ...message });
     });
   },
   
-  // Copy code to clipboard
-  copyCode(code) {
-    if (!code) {
-      console.error('No code provided to copy');
-      this.showToast('Failed to copy: No code provided', 'error');
-      return;
+  // Lazily create the spec worker (null if Workers are unavailable)
+  getSpecWorker() {
+    if (this.specWorker !== undefined) {
+      return this.specWorker;
     }
     
-    // Decode HTML entities in the code
-    const decodedCode = code.replace(/&amp;/g, '&')
-                            .replace(/&lt;/g, '<')
-                            .replace(/&gt;/g, '>')
-                            .replace(/&quot;/g, '"')
-                            .replace(/&#39;/g, "'");
-
-    navigator.clipboard.writeText(decodedCode).then(() => {
-      this.showToast('Code copied to clipboard', 'success');
-    }).catch(err => {
-      console.error('Copy failed:', err);
-      this.showToast('Failed to copy code', 'error');
-      
-      // Fallback for browsers that don't support clipboard API
-      const textarea = document.createElement('textarea');
-      textarea.value = decodedCode;
-      textarea.style.position = 'fixed';
-      textarea.style.opacity = '0';
-      document.body.appendChild(textarea);
-      textarea.select();
-      
-      try {
-        const successful = document.execCommand('copy');
-        if (successful) {
-          this.showToast('Code copied to clipboard (fallback method)', 'success');
+    this.specWorker = null;
+    this.specRequests = new Map();
+    this.specRequestSeq = 0;
+    
+    if (typeof Worker === 'undefined') {
+      return null;
+    }
+    
+    try {
+      const worker = new Worker(this.getSpecWorkerUrl());
+      worker.onmessage = (event) => {
+        const { id, error, ...result } = event.data || {};
+        const pending = this.specRequests.get(id);
+        if (!pending) return;
+        this.specRequests.delete(id);
+        if (error) {
+          pending.reject(new Error(error));
         } else {
-          this.showToast('Copy failed with fallback method', 'error');
+          pending.resolve(result);
         }
-      } catch (err) {
-        console.error('Fallback copy failed:', err);
-        this.showToast('Failed to copy code', 'error');
-      }
-      
-      document.body.removeChild(textarea);
-    });
+      };
+      worker.onerror = (event) => {
+        console.warn('Spec worker failed, falling back to main thread:', event.message);
+        this.specWorker.terminate();
+        this.specWorker = null;
+        this.specRequests.forEach(pending => pending.reject(new Error('Spec worker failed')));
+        this.specRequests.clear();
+      };
+      this.specWorker = worker;
+    } catch (error) {
+      console.warn('Could not start spec worker, parsing on main thread:', error);
+    }
+    
+    return this.specWorker;
   },
   
-  // Fetch OpenAPI specification based on selected spec
-  async fetchOpenAPISpec() {
-    try {
-      const selectedSpecInfo = this.state.availableSpecs.find(spec => spec.id === this.state.selectedSpec);
-      if (!selectedSpecInfo) {
-        throw new Error('No selected specification available');
-      }
-      
-      const response = await fetch(selectedSpecInfo.url, {
-        method: 'GET',
-        headers: {
-          'Accept': 'application/json',
-          'Cache-Control': 'no-cache'
-        },
-        credentials: 'include'
+  getSpecWorkerUrl() {
+    return `${AuthUtils.getModulePrefix()}/assets/maker-api-spec-worker.js`;
+  },
+  
+  // Fallback for browsers without Worker support - loads the same parser as a
+  // classic script and runs it here
+  async runSpecParserOnMainThread(message) {
+    if (typeof MakerAPISpecParser === 'undefined') {
+      await new Promise((resolve, reject) => {
+        const script = document.createElement('script');
+        script.src = this.getSpecWorkerUrl();
+        script.onload = resolve;
+        script.onerror = () => reject(new Error('Failed to load spec parser'));
+        document.head.appendChild(script);
       });
-      
-      if (!response.ok) {
-        throw new Error(`Failed to fetch OpenAPI spec: HTTP ${response.status} ${response.statusText}`);
-      }
-
-      const spec = await response.json();
-      
-      // Validate the spec has the required structure
-      if (!spec.paths) {
-        throw new Error('Invalid OpenAPI spec: missing "paths" property');
-      }
-      
-      this.state.openApiSpec = spec;
-      return spec;
-      
-    } catch (error) {
-      console.error('Error fetching OpenAPI spec:', error);
-      throw new Error(`Failed to load API specification: ${error.message}`);
     }
+    
+    if (message.since) {
+      return MakerAPISpecParser.refresh(message.url, message.since);
+    }
+    return { model: await MakerAPISpecParser.load(message.url) };
   },
   
   // UI State management
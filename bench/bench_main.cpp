@@ -0,0 +1,213 @@
+// Native micro-benchmarks for the module's hot paths. Built by the
+// bench_native env (-O2, no coverage):
+//
+//   pio run -e bench_native -t exec
+//
+// Prints one line per benchmark and writes the results as JSON to
+// bench_output.txt (or the path given as the first argument); compare two
+// runs with tools/compare_bench.py.
+
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <testing/testing_platform_provider.h>
+
+#include <maker_api.h>
+
+// Global allocation counters - every operator new in the process is counted
+// while a benchmark runs
+static size_t allocations = 0;
+static size_t allocatedBytes = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  allocatedBytes += size;
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work
+volatile size_t sink = 0;
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double nsPerOp;
+  double allocsPerOp;
+  double bytesPerOp;
+};
+
+// Run fn in doubling batches until one batch takes at least 200ms, after a
+// short warm-up, and report the per-op figures of that batch
+template <typename Fn> Result measure(const char *name, Fn fn) {
+  using Clock = std::chrono::steady_clock;
+  const auto target = std::chrono::milliseconds(200);
+
+  for (int i = 0; i < 10; i++) {
+    fn();
+  }
+
+  uint64_t iterations = 1;
+  while (true) {
+    const size_t allocationsBefore = allocations;
+    const size_t bytesBefore = allocatedBytes;
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+      fn();
+    }
+    const auto elapsed = Clock::now() - start;
+
+    if (elapsed >= target || iterations >= (1ULL << 30)) {
+      const double ops = static_cast<double>(iterations);
+      return {name, iterations,
+              std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+              (allocations - allocationsBefore) / ops,
+              (allocatedBytes - bytesBefore) / ops};
+    }
+    iterations *= 2;
+  }
+}
+
+WebRoute webRouteOf(const RouteVariant &route) {
+  return route.isApiRoute() ? route.getApiRoute().webRoute
+                            : route.getWebRoute();
+}
+
+WebRoute routeAt(const std::vector<RouteVariant> &routes, const char *path) {
+  for (const RouteVariant &route : routes) {
+    WebRoute webRoute = webRouteOf(route);
+    if (webRoute.path == path) {
+      return webRoute;
+    }
+  }
+  std::fprintf(stderr, "No route %s\n", path);
+  std::exit(1);
+}
+
+void writeJson(const std::vector<Result> &results, const char *path) {
+  FILE *out = std::fopen(path, "w");
+  if (!out) {
+    std::perror(path);
+    std::exit(1);
+  }
+  std::fprintf(out, "{\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    std::fprintf(out,
+                 "    {\"name\": \"%s\", \"iterations\": %llu, "
+                 "\"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, "
+                 "\"bytes_per_op\": %.1f}%s\n",
+                 r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                 r.nsPerOp, r.allocsPerOp, r.bytesPerOp,
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+  std::fclose(out);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *outputPath = argc > 1 ? argv[1] : "bench_output.txt";
+
+  MockWebPlatformProvider provider;
+  IWebPlatformProvider::instance = &provider;
+  MakerAPIModule module(&provider);
+  module.begin();
+
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  const WebRoute config = routeAt(routes, "/config");
+  const WebRoute dashboard = routeAt(routes, "/");
+  const WebRoute styles = routeAt(routes, "/assets/maker-api-style.css");
+
+  // The instrument() wrapper around a handler that does nothing. Native
+  // freeHeap() is a stub, so the heap delta's cost only shows on device
+  // (test_esp32_instrument_overhead).
+  std::vector<RouteVariant> noop = {WebRoute(
+      "/noop", WebModule::WM_GET, [](RequestT &, ResponseT &) {},
+      {AuthType::NONE})};
+  const WebRoute bare = routeAt(noop, "/noop");
+  const WebRoute instrumented =
+      routeAt(module.instrumentRoutes("Bench", noop), "/noop");
+
+  std::vector<Result> results;
+
+  results.push_back(measure("getHttpRoutes", [&module]() {
+    sink = sink + module.getHttpRoutes().size();
+  }));
+
+  results.push_back(measure("getOpenAPIConfigDocs", [&module]() {
+    sink = sink + module.getOpenAPIConfigDocs().getSummary().length();
+  }));
+
+  results.push_back(measure("configHandler", [&config]() {
+    RequestT req;
+    ResponseT res;
+    config.unifiedHandler(req, res);
+    sink = sink + res.getContent().length();
+  }));
+
+  results.push_back(measure("dashboardAsset", [&dashboard]() {
+    RequestT req;
+    ResponseT res;
+    dashboard.unifiedHandler(req, res);
+    sink = sink + res.getStatus();
+  }));
+
+  results.push_back(measure("stylesAsset", [&styles]() {
+    RequestT req;
+    ResponseT res;
+    styles.unifiedHandler(req, res);
+    sink = sink + res.getStatus();
+  }));
+
+  results.push_back(measure("bareHandler", [&bare]() {
+    RequestT req;
+    ResponseT res;
+    bare.unifiedHandler(req, res);
+    sink = sink + res.getStatus();
+  }));
+
+  results.push_back(measure("instrumentedHandler", [&instrumented]() {
+    RequestT req;
+    ResponseT res;
+    instrumented.unifiedHandler(req, res);
+    sink = sink + res.getStatus();
+  }));
+
+  module.getMetrics().setHeapDeltaEnabled(false);
+  results.push_back(measure("instrumentedNoHeapDelta", [&instrumented]() {
+    RequestT req;
+    ResponseT res;
+    instrumented.unifiedHandler(req, res);
+    sink = sink + res.getStatus();
+  }));
+  module.getMetrics().setHeapDeltaEnabled(true);
+
+  for (const Result &r : results) {
+    std::printf("%-24s %12.1f ns/op %8.2f allocs/op %10.1f B/op\n",
+                r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+  }
+  writeJson(results, outputPath);
+  std::printf("Wrote %s\n", outputPath);
+
+  IWebPlatformProvider::instance = nullptr;
+  return 0;
+}
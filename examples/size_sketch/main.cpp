@@ -0,0 +1,16 @@
+// Smallest sketch that links the module, built by the esp32-s3-size env so
+// the footprint report can measure what actually ends up in the firmware:
+//
+//   pio run -e esp32-s3-size -t size_report
+//
+// The global makerAPI instance keeps every route handler and asset its
+// routes reference alive through the module's vtable, so nothing is dropped
+// here that an application serving the module would keep.
+
+#include <Arduino.h>
+
+#include <maker_api.h>
+
+void setup() { makerAPI.begin(); }
+
+void loop() { makerAPI.handle(); }
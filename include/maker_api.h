@@ -7,8 +7,16 @@
 #include <ArduinoFake.h>
 #endif
 
+#include <ArduinoJson.h>
+
 #include <interface/request_response_types.h>
 #include <web_platform_interface.h>
+#include "maker_api_benchmark.h"
+#include "maker_api_heap.h"
+#include "maker_api_json_arena.h"
+#include "maker_api_metrics.h"
+#include "maker_api_prometheus.h"
+#include "maker_api_trace.h"
 #include "version_autogen.h"
 
 // Version must be injected at build time from library.json as
@@ -18,6 +26,64 @@
 #error "WEB_MODULE_VERSION_STR not defined (version_autogen.h missing)."
 #endif
 
+// Default reconnect interval for /api/metrics/stream
+#ifndef MAKER_API_METRICS_STREAM_INTERVAL_MS
+#define MAKER_API_METRICS_STREAM_INTERVAL_MS 2000
+#endif
+
+// Most bytes the Prometheus route reserves up front for its body. A full
+// route table needs far more (~3.4 KB per active route); the rest grows in
+// place, so on a fragmented heap the scrape fails instead of one large block
+// being demanded before anything is written.
+#ifndef MAKER_API_PROMETHEUS_RESERVE_BYTES
+#define MAKER_API_PROMETHEUS_RESERVE_BYTES 4096
+#endif
+
+// Most calls accepted in one /api/batch request
+#ifndef MAKER_API_BATCH_MAX_CALLS
+#define MAKER_API_BATCH_MAX_CALLS 8
+#endif
+
+// Path the application registers the module under
+// (webPlatform.registerModule()); see setBasePath()
+#ifndef MAKER_API_BASE_PATH
+#define MAKER_API_BASE_PATH "/api-explorer"
+#endif
+
+// Headless production mode: no dashboard, no assets and no telemetry
+// routes - only a JSON index at the module root pointing at the spec and
+// /api/config, both serialized once in begin() and served with an ETag.
+// Route instrumentation still works for other modules' routes.
+#ifndef MAKER_API_HEADLESS
+#define MAKER_API_HEADLESS 0
+#endif
+
+// Optional dashboard features, on by default unless headless. Each ships as
+// its own script that the dashboard loads only when /api/config lists it;
+// building with -DMAKER_API_FEATURE_<NAME>=0 drops the script and any route
+// behind it from the firmware.
+#ifndef MAKER_API_FEATURE_CODEGEN
+#define MAKER_API_FEATURE_CODEGEN (!MAKER_API_HEADLESS) // cURL/Override tabs
+#endif
+
+#ifndef MAKER_API_FEATURE_TOKENS
+#define MAKER_API_FEATURE_TOKENS (!MAKER_API_HEADLESS) // Token picker
+#endif
+
+#ifndef MAKER_API_FEATURE_LOAD_TEST
+#define MAKER_API_FEATURE_LOAD_TEST (!MAKER_API_HEADLESS) // + /api/benchmark
+#endif
+
+#ifndef MAKER_API_FEATURE_BATCH
+#define MAKER_API_FEATURE_BATCH (!MAKER_API_HEADLESS) // + /api/batch
+#endif
+
+#if MAKER_API_HEADLESS &&                                                      \
+    (MAKER_API_FEATURE_CODEGEN || MAKER_API_FEATURE_TOKENS ||                  \
+     MAKER_API_FEATURE_LOAD_TEST || MAKER_API_FEATURE_BATCH)
+#error "MAKER_API_HEADLESS has no dashboard - leave MAKER_API_FEATURE_* unset"
+#endif
+
 class MakerAPIModule : public IWebModule {
 public:
   // Default constructor - uses global provider instance
@@ -43,16 +109,191 @@ public:
   }
 
   OpenAPIDocumentation getOpenAPIConfigDocs() const;
+  OpenAPIDocumentation getMetricsDocs() const;
+  OpenAPIDocumentation getLoopTimingDocs() const;
+  OpenAPIDocumentation getHeapDocs() const;
+  OpenAPIDocumentation getTraceDocs() const;
+  OpenAPIDocumentation getMetricsStreamDocs() const;
+#if MAKER_API_FEATURE_BATCH
+  OpenAPIDocumentation getBatchDocs() const;
+#endif
+#if MAKER_API_FEATURE_LOAD_TEST
+  OpenAPIDocumentation getBenchmarkDocs() const;
+#endif
+
+  // Fingerprint of the embedded dashboard assets (8 hex chars), computed in
+  // begin(). Used as the asset ETag and the service worker cache version.
+  // Empty when headless.
+  const String &getAssetVersion() const { return assetVersion; }
+
+  // The path the module is registered under, for the absolute URLs of the
+  // headless index and the baked spec. Defaults to MAKER_API_BASE_PATH;
+  // call before begin().
+  void setBasePath(const String &path) { basePath = path; }
+  const String &getBasePath() const { return basePath; }
+
+  // Serve a maker spec baked at build time (the bake_native env) from
+  // flash at <module>/openapi.json, instead of the platform generating one
+  // at runtime. /api/config points the dashboard at it. json must stay
+  // valid (a PROGMEM string); call before begin().
+  void setBakedSpec(const char *json);
+
+  // Opt a module's routes into the metrics table served at /api/metrics:
+  // each wrapped handler records its count, latency and heap delta. With
+  // tags, only ApiRoutes documented with one of them are wrapped; without,
+  // every route is. Call from the module's getHttpRoutes(), e.g.
+  //   return makerAPI.instrumentRoutes(getModuleName(), routes, {"maker"});
+  std::vector<RouteVariant>
+  instrumentRoutes(const String &moduleName, std::vector<RouteVariant> routes,
+                   const std::vector<String> &tags = {});
+
+  // Route metrics, heap and uptime in Prometheus text format - what the
+  // /metrics route serves
+  void writePrometheusMetrics(MetricsSink &sink) const;
+
+  const RouteMetrics &getMetrics() const { return metrics; }
+  RouteMetrics &getMetrics() { return metrics; }
+
+  // Arena the module's JSON responses are built in (see JsonArena)
+  JsonArena::Stats getJsonArenaStats() const { return jsonArena.getStats(); }
+
+  // Gaps between handle() calls, i.e. main-loop latency
+  const LoopTiming &getLoopTiming() const { return loopTiming; }
+
+  // Heap statistics source for /api/heap, the heap history and the
+  // Prometheus output. Defaults to the system allocator; nullptr restores it.
+  void setHeapStatsProvider(IHeapStatsProvider *provider) {
+    heapStats = provider ? provider : &systemHeapStats;
+  }
+
+  // Where the module's buffers live - metrics table, trace ring, heap
+  // history, JSON arena and the per-request copies /api/heap, /api/trace
+  // and /api/benchmark work in. Defaults to PSRAM when the board has it and the
+  // internal heap otherwise (SystemBufferAllocator); nullptr restores that.
+  // Call before begin(): buffers already allocated stay where they are.
+  void setBufferAllocator(IBufferAllocator *allocator);
+
+  // Heap samples taken from handle() every MAKER_API_HEAP_SAMPLE_INTERVAL_MS
+  const HeapHistory &getHeapHistory() const { return heapHistory; }
+
+  // How often dashboards poll /api/metrics/stream for the metrics that
+  // changed since their last event
+  void setMetricsStreamInterval(uint32_t ms) { metricsStreamIntervalMs = ms; }
+
+  // What /api/metrics/stream answers a client that last saw lastEventId
+  // (empty for a first request): the retry interval, the new ID and, if
+  // anything changed since, one event holding only those changes
+  String getMetricsStreamEvent(const String &lastEventId) const;
+
+  // Record the last MAKER_API_TRACE_SLOTS requests on instrumented routes,
+  // downloadable from /api/trace as a Chrome trace (open in Perfetto or
+  // chrome://tracing). Off by default; false if the ring can't be allocated.
+  bool setRequestTracing(bool enabled) {
+    return requestTrace.setEnabled(enabled);
+  }
+  const RequestTrace &getRequestTrace() const { return requestTrace; }
 
 private:
   // Platform provider (injected or global)
   IWebPlatformProvider *platformProvider;
 
+  // Asset fingerprint (see getAssetVersion())
+  String assetVersion;
+
+  // See setBasePath()
+  String basePath = MAKER_API_BASE_PATH;
+
+  // Build-time maker spec and its ETag (see setBakedSpec())
+  const char *bakedSpec = nullptr;
+  String bakedSpecETag;
+
+  // Per-route metrics (see instrumentRoutes())
+  RouteMetrics metrics;
+
+  // Recorded from handle() (see getLoopTiming())
+  LoopTiming loopTiming;
+
+  // Heap telemetry (see setHeapStatsProvider()/getHeapHistory())
+  SystemHeapStatsProvider systemHeapStats;
+  IHeapStatsProvider *heapStats = &systemHeapStats;
+  HeapHistory heapHistory;
+  uint32_t lastHeapSampleMicros = 0;
+
+  uint32_t metricsStreamIntervalMs = MAKER_API_METRICS_STREAM_INTERVAL_MS;
+
+  // Recent requests (see setRequestTracing())
+  RequestTrace requestTrace;
+
+  // Per-response JSON documents (see sendJson()). Leased and reset by
+  // const handlers, hence mutable.
+  mutable JsonArena jsonArena;
+
+  // See setBufferAllocator()
+  IBufferAllocator *bufferAllocator = &SystemBufferAllocator::instance();
+
+#if MAKER_API_HEADLESS
+  // Response body serialized once in begin(), with its ETag
+  struct CachedResponse {
+    String body;
+    String etag;
+  };
+  CachedResponse indexResponse;
+  CachedResponse configResponse;
+#endif
+
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+  // Instrumented routes' handlers by metrics slot: wrapped for /api/batch,
+  // bare for /api/benchmark so benchmark runs stay out of the metrics
+  struct RouteTarget {
+    decltype(WebRoute::unifiedHandler) handler;
+    decltype(WebRoute::unifiedHandler) unwrapped;
+    decltype(WebRoute::authRequirements) authRequirements;
+  };
+  RouteTarget routeTargets[RouteMetrics::kMaxRoutes];
+#endif
+
   // Helper to access the platform
   IWebPlatform &getPlatform() const { return platformProvider->getPlatform(); }
 
-  // Internal handler
+  // Internal handlers
+  template <typename Builder>
+  void sendJson(ResponseT &res, Builder build) const;
+  void writeOpenAPIConfig(JsonObject &root) const;
   void getOpenAPIConfigHandler(RequestT &req, ResponseT &res) const;
+  void getMetricsHandler(RequestT &req, ResponseT &res) const;
+  void getPrometheusMetricsHandler(RequestT &req, ResponseT &res) const;
+  void getLoopTimingHandler(RequestT &req, ResponseT &res) const;
+  void getHeapHandler(RequestT &req, ResponseT &res) const;
+  void getTraceHandler(RequestT &req, ResponseT &res) const;
+  void getMetricsStreamHandler(RequestT &req, ResponseT &res) const;
+#if MAKER_API_FEATURE_BATCH
+  void batchHandler(RequestT &req, ResponseT &res) const;
+#endif
+#if MAKER_API_FEATURE_LOAD_TEST
+  void benchmarkHandler(RequestT &req, ResponseT &res) const;
+#endif
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+  int findRouteTarget(const char *method, const char *path,
+                      const char *module) const;
+  void sendError(ResponseT &res, int status, const char *message) const;
+  // 503 for a request whose working buffer couldn't be allocated
+  void sendOutOfMemory(ResponseT &res) const;
+  RequestT callRequest(RequestT &req, JsonObject call, int slot,
+                       const char *path) const;
+#endif
+  void sampleHeap();
+  void instrument(const String &moduleName, WebRoute &route);
+  void serveAsset(RequestT &req, ResponseT &res, const char *content,
+                  const char *mimeType) const;
+  void serveBakedSpec(RequestT &req, ResponseT &res) const;
+  void addBakedSpecRoute(std::vector<RouteVariant> &routes);
+#if MAKER_API_HEADLESS
+  void writeIndex(JsonObject &root) const;
+  static void cacheJson(const JsonDocument &doc, CachedResponse &cached);
+  void serveCached(RequestT &req, ResponseT &res,
+                   const CachedResponse &cached) const;
+  std::vector<RouteVariant> getHeadlessRoutes();
+#endif
 };
 
 // Global instance for production builds
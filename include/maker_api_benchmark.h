@@ -0,0 +1,82 @@
+#ifndef MAKER_API_BENCHMARK_H
+#define MAKER_API_BENCHMARK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_heap.h"
+#include "maker_api_metrics.h"
+
+// Most iterations one benchmark run records, and the wall-clock budget after
+// which it stops early - it runs on the HTTP task, blocking other requests
+#ifndef MAKER_API_BENCHMARK_MAX_ITERATIONS
+#define MAKER_API_BENCHMARK_MAX_ITERATIONS 100
+#endif
+
+#ifndef MAKER_API_BENCHMARK_BUDGET_MS
+#define MAKER_API_BENCHMARK_BUDGET_MS 2000
+#endif
+
+// Runs a handler repeatedly in-process and records each iteration's time,
+// heap consumption and response size - handler cost without the network.
+// Heap is read outside the timed window, so a slow provider doesn't skew
+// the times.
+class HandlerBenchmark {
+public:
+  static constexpr size_t kMaxIterations = MAKER_API_BENCHMARK_MAX_ITERATIONS;
+
+  struct Iteration {
+    uint32_t micros;
+    int32_t heapDelta; // bytes of free heap consumed
+    uint32_t bytes;    // response body size
+  };
+
+  struct Summary {
+    size_t iterations;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint32_t avgMicros;
+    uint32_t p50Micros; // exact - every iteration is kept
+    uint32_t p90Micros;
+    int32_t heapDeltaMax;
+    uint32_t bytes; // last response size
+  };
+
+  // Call invoke() (which runs the handler once and returns the response
+  // size) up to `iterations` times, stopping early once budgetMicros have
+  // passed. Replaces any previous run; returns the number of iterations.
+  template <typename Invoke>
+  size_t run(const IHeapStatsProvider &heap, size_t iterations,
+             uint32_t budgetMicros, Invoke invoke) {
+    if (iterations > kMaxIterations) {
+      iterations = kMaxIterations;
+    }
+    count = 0;
+    const uint32_t started = RouteMetrics::nowMicros();
+    while (count < iterations &&
+           (count == 0 || RouteMetrics::nowMicros() - started < budgetMicros)) {
+      const uint32_t heapBefore = heap.read().freeBytes;
+      const uint32_t start = RouteMetrics::nowMicros();
+      const uint32_t bytes = static_cast<uint32_t>(invoke());
+      const uint32_t micros = RouteMetrics::nowMicros() - start;
+
+      Iteration &iteration = results[count++];
+      iteration.micros = micros;
+      iteration.heapDelta =
+          static_cast<int32_t>(heapBefore - heap.read().freeBytes);
+      iteration.bytes = bytes;
+    }
+    return count;
+  }
+
+  size_t size() const { return count; }
+  const Iteration &iteration(size_t index) const { return results[index]; }
+
+  Summary summarize() const;
+
+private:
+  Iteration results[kMaxIterations] = {};
+  size_t count = 0;
+};
+
+#endif // MAKER_API_BENCHMARK_H
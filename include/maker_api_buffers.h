@@ -0,0 +1,87 @@
+#ifndef MAKER_API_BUFFERS_H
+#define MAKER_API_BUFFERS_H
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Where a buffer may live. ESP32 targets can't run atomic read-modify-write
+// instructions on PSRAM, so buffers updated that way ask for internal RAM.
+enum class BufferPlacement {
+  PreferPsram, // PSRAM when the board has it, internal heap otherwise
+  Internal,
+};
+
+// Source of the module's large, long-lived buffers (metrics table, trace
+// ring, heap history, JSON arena)
+class IBufferAllocator {
+public:
+  virtual ~IBufferAllocator() = default;
+  virtual void *allocate(size_t size, BufferPlacement placement) = 0;
+  virtual void deallocate(void *ptr) = 0;
+};
+
+// ESP heap_caps: PSRAM first for PreferPsram, falling back to the internal
+// heap. Plain malloc on native builds.
+class SystemBufferAllocator : public IBufferAllocator {
+public:
+  void *allocate(size_t size, BufferPlacement placement) override;
+  void deallocate(void *ptr) override;
+
+  // Shared default for buffers created outside a module
+  static SystemBufferAllocator &instance();
+};
+
+// Native stand-in: heap memory, with psramCapacity bytes of simulated PSRAM
+// handed out first and every live buffer's placement recorded - for tests
+class FakeBufferAllocator : public IBufferAllocator {
+public:
+  size_t psramCapacity = 0; // 0 = a board without PSRAM
+  bool failAll = false;     // Simulate an exhausted heap
+
+  void *allocate(size_t size, BufferPlacement placement) override;
+  void deallocate(void *ptr) override;
+
+  size_t psramBytes() const;
+  size_t internalBytes() const;
+  size_t liveBuffers() const { return buffers.size(); }
+  bool inPsram(const void *ptr) const;
+
+private:
+  struct Buffer {
+    void *ptr;
+    size_t size;
+    bool psram;
+  };
+  std::vector<Buffer> buffers;
+};
+
+// Allocate and default-construct count objects (which may hold atomics) in
+// one buffer. nullptr when the allocation fails.
+template <typename T>
+T *allocateBuffer(IBufferAllocator &allocator, size_t count,
+                  BufferPlacement placement) {
+  void *memory = allocator.allocate(sizeof(T) * count, placement);
+  if (!memory) {
+    return nullptr;
+  }
+  T *items = static_cast<T *>(memory);
+  for (size_t i = 0; i < count; i++) {
+    new (&items[i]) T();
+  }
+  return items;
+}
+
+template <typename T>
+void freeBuffer(IBufferAllocator &allocator, T *items, size_t count) {
+  if (!items) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    items[i].~T();
+  }
+  allocator.deallocate(items);
+}
+
+#endif // MAKER_API_BUFFERS_H
@@ -0,0 +1,102 @@
+#ifndef MAKER_API_HEAP_H
+#define MAKER_API_HEAP_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_buffers.h"
+
+// Heap history length and sampling interval - the defaults keep two hours
+#ifndef MAKER_API_HEAP_SAMPLES
+#define MAKER_API_HEAP_SAMPLES 120
+#endif
+
+#ifndef MAKER_API_HEAP_SAMPLE_INTERVAL_MS
+#define MAKER_API_HEAP_SAMPLE_INTERVAL_MS 60000
+#endif
+
+struct HeapStats {
+  uint32_t freeBytes;
+  uint32_t largestFreeBlock;
+  uint32_t minFreeBytes; // low-water mark since boot
+  uint32_t totalBytes;
+  uint32_t psramFreeBytes; // PSRAM fields are 0 without PSRAM
+  uint32_t psramLargestFreeBlock;
+  uint32_t psramTotalBytes;
+
+  // 0-100: how much of the free heap is unusable for one allocation of that
+  // size (100 * (1 - largest / free))
+  uint32_t fragmentationPercent() const {
+    if (freeBytes == 0) {
+      return 0;
+    }
+    return 100 - static_cast<uint32_t>(
+                     static_cast<uint64_t>(largestFreeBlock) * 100 / freeBytes);
+  }
+};
+
+// Source of heap statistics
+class IHeapStatsProvider {
+public:
+  virtual ~IHeapStatsProvider() = default;
+  virtual HeapStats read() const = 0;
+};
+
+// The device's own allocator (ESP heap_caps). On native builds there is no
+// allocator to ask, so this reports all zeros - inject a
+// FakeHeapStatsProvider instead.
+class SystemHeapStatsProvider : public IHeapStatsProvider {
+public:
+  HeapStats read() const override;
+};
+
+// Returns whatever stats it is given - for native tests and simulations
+class FakeHeapStatsProvider : public IHeapStatsProvider {
+public:
+  HeapStats stats = {};
+  HeapStats read() const override { return stats; }
+};
+
+// Ring of periodic heap samples, written from the loop and read from request
+// handlers (possibly on another task). Readers drop any sample the writer
+// may have overwritten while they copied. The ring is allocated (in PSRAM
+// when present) by the first add().
+class HeapHistory {
+public:
+  static constexpr size_t kSamples = MAKER_API_HEAP_SAMPLES;
+
+  HeapHistory() = default;
+  ~HeapHistory();
+  HeapHistory(const HeapHistory &) = delete;
+  HeapHistory &operator=(const HeapHistory &) = delete;
+
+  // Where the ring is allocated. Ignored once it is allocated.
+  void setBufferAllocator(IBufferAllocator &allocator) {
+    if (!samples.load(std::memory_order_relaxed)) {
+      bufferAllocator = &allocator;
+    }
+  }
+
+  struct Sample {
+    uint32_t uptimeSeconds;
+    uint32_t freeBytes;
+    uint32_t largestFreeBlock;
+    uint32_t minFreeBytes;
+    uint32_t psramFreeBytes;
+  };
+
+  void add(const Sample &sample);
+
+  // Copy up to max samples, oldest first. Returns how many were copied.
+  size_t copy(Sample *out, size_t max) const;
+
+  uint32_t totalAdded() const { return added.load(std::memory_order_acquire); }
+
+private:
+  IBufferAllocator *bufferAllocator = &SystemBufferAllocator::instance();
+  std::atomic<Sample *> samples{nullptr}; // kSamples
+  std::atomic<uint32_t> added{0};
+};
+
+#endif // MAKER_API_HEAP_H
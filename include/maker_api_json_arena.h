@@ -0,0 +1,89 @@
+#ifndef MAKER_API_JSON_ARENA_H
+#define MAKER_API_JSON_ARENA_H
+
+#include <ArduinoJson.h>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_buffers.h"
+
+// Bytes reserved for building one JSON response, allocated on first use (in
+// PSRAM when present). Size it from the highWater reported in /api/metrics.
+// ArduinoJson's slots (and so its pools) are twice as large on 64-bit hosts.
+#ifndef MAKER_API_JSON_ARENA_SIZE
+#define MAKER_API_JSON_ARENA_SIZE (sizeof(void *) > 4 ? 8192 : 4096)
+#endif
+
+// Bump allocator for the JsonDocument of one response at a time, reset
+// when the response is done, so building JSON never touches the general
+// heap. Freeing or growing the newest block works in place (ArduinoJson
+// grows its pools and strings that way); anything else is only reclaimed
+// by the reset. Requests that don't fit, or arrive while another response
+// holds the arena, fall back to the heap and are counted.
+class JsonArena : public ArduinoJson::Allocator {
+public:
+  struct Stats {
+    uint32_t capacity;
+    uint32_t highWater; // Most bytes one response used
+    uint32_t lastUsed;  // Bytes the latest response used
+    uint32_t leases;    // Responses built in the arena
+    uint32_t overflows; // Allocations that didn't fit and went to the heap
+    uint32_t contended; // Responses built on the heap (arena in use)
+  };
+
+  // Holds the arena for one response and resets it when destroyed; use
+  // allocator() for the response's JsonDocument
+  class Lease {
+  public:
+    explicit Lease(JsonArena &arena);
+    ~Lease();
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    ArduinoJson::Allocator *allocator() const;
+
+  private:
+    JsonArena *arena; // nullptr when the heap is used instead
+  };
+
+  explicit JsonArena(size_t capacity = MAKER_API_JSON_ARENA_SIZE)
+      : capacity(capacity) {}
+  ~JsonArena();
+  JsonArena(const JsonArena &) = delete;
+  JsonArena &operator=(const JsonArena &) = delete;
+
+  // Where the buffer is allocated. Ignored once it is allocated.
+  void setBufferAllocator(IBufferAllocator &allocator) {
+    if (!buffer) {
+      bufferAllocator = &allocator;
+    }
+  }
+
+  Stats getStats() const;
+
+  void *allocate(size_t size) override;
+  void deallocate(void *ptr) override;
+  void *reallocate(void *ptr, size_t newSize) override;
+
+private:
+  IBufferAllocator *bufferAllocator = &SystemBufferAllocator::instance();
+  uint8_t *buffer = nullptr;
+  const size_t capacity;
+  size_t used = 0;
+  size_t peak = 0;      // Most bytes used during the current lease
+  size_t lastBlock = 0; // Offset of the newest block's header
+  bool hasLastBlock = false;
+
+  uint32_t highWater = 0;
+  uint32_t lastUsed = 0;
+  uint32_t leases = 0;
+  uint32_t overflows = 0;
+  std::atomic<uint32_t> contended{0};
+  std::atomic<bool> busy{false};
+
+  bool owns(const void *ptr) const;
+  void reset();
+};
+
+#endif // MAKER_API_JSON_ARENA_H
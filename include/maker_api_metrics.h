@@ -0,0 +1,231 @@
+#ifndef MAKER_API_METRICS_H
+#define MAKER_API_METRICS_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_buffers.h"
+
+// Number of routes that can be instrumented. Each slot is ~470 bytes, most
+// of it the latency histogram; the table is allocated on the first
+// registration.
+#ifndef MAKER_API_METRICS_MAX_ROUTES
+#define MAKER_API_METRICS_MAX_ROUTES 16
+#endif
+
+// Most an instrumented request may spend reading the free heap before and
+// after its handler, in nanoseconds. Half the wrapper's 1us budget: on parts
+// where ESP.getFreeHeap() walks every heap region the heap delta is skipped
+// (see RouteMetrics::calibrateHeapDelta()).
+#ifndef MAKER_API_HEAP_DELTA_BUDGET_NS
+#define MAKER_API_HEAP_DELTA_BUDGET_NS 500
+#endif
+
+// Latency histogram with a fixed log-linear (HDR-style) bucket layout: exact
+// below 8us, then every power-of-two range split into 4 equal buckets, up to
+// 2^25us (~33s) - so any recorded value is known to within 25% (12.5% from
+// the bucket midpoint) in constant memory. Longer values are counted in a
+// separate overflow bucket with no upper bound. Counts are relaxed atomics;
+// recording is a bucket computation and one fetch_add.
+class LatencyHistogram {
+public:
+  static constexpr uint32_t kSubBucketBits = 2;
+  static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+  static constexpr uint32_t kMaxExponent = 25; // Last finite bound, 2^25us
+  // Finite buckets, [0, 2^25us)
+  static constexpr size_t kBuckets =
+      2 * kSubBuckets + (kMaxExponent - kSubBucketBits - 1) * kSubBuckets;
+  // Values >= 2^25us, after the finite buckets (+Inf)
+  static constexpr size_t kOverflowBucket = kBuckets;
+
+  void record(uint32_t micros) {
+    counts[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint32_t count(size_t bucket) const {
+    return counts[bucket].load(std::memory_order_relaxed);
+  }
+
+  uint32_t totalCount() const;
+
+  // Value at percentile (0-100), as the midpoint of the bucket holding that
+  // rank (nearest-rank method). 0 when empty, UINT32_MAX when the rank is in
+  // the overflow bucket.
+  uint32_t percentile(double percent) const;
+
+  void reset();
+
+  // kOverflowBucket for values >= 2^25us
+  static size_t bucketFor(uint32_t micros);
+  // Bounds of the finite buckets; the overflow bucket starts at 2^25us
+  static uint32_t bucketLowerBound(size_t bucket);
+  static uint32_t bucketWidth(size_t bucket);
+
+private:
+  std::atomic<uint32_t> counts[kBuckets + 1] = {};
+};
+
+// Per-route latency and heap metrics.
+//
+// Slots are claimed when routes are instrumented (route registration, before
+// the server starts serving) and updated with relaxed atomics from the
+// request path - recording takes no lock and never allocates. Readers see
+// each counter atomically but not a consistent snapshot across counters,
+// which is fine for monitoring.
+class RouteMetrics {
+public:
+  static constexpr size_t kMaxRoutes = MAKER_API_METRICS_MAX_ROUTES;
+  static constexpr size_t kMaxModuleLength = 16;
+  static constexpr size_t kMaxPathLength = 40;
+
+  struct Snapshot {
+    const char *module;
+    const char *path;
+    const char *method;
+    uint32_t count;
+    uint64_t totalMicros;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    int32_t heapDeltaTotal; // bytes of free heap consumed, summed
+    int32_t heapDeltaMax;   // largest single-request consumption
+    uint32_t changedAt;     // generation of the last change
+    const LatencyHistogram *histogram;
+  };
+
+  RouteMetrics() = default;
+  ~RouteMetrics();
+  RouteMetrics(const RouteMetrics &) = delete;
+  RouteMetrics &operator=(const RouteMetrics &) = delete;
+
+  // Where the table is allocated (internal RAM - its counters are updated
+  // with atomic read-modify-writes). Ignored once it is allocated.
+  void setBufferAllocator(IBufferAllocator &allocator) {
+    if (!slots) {
+      bufferAllocator = &allocator;
+    }
+  }
+
+  // Claim (or find the existing) slot for a route. Returns -1 when the table
+  // is full. Names longer than the slot buffers are truncated.
+  int registerRoute(const char *module, const char *path, const char *method);
+
+  // Request path: record one handler invocation
+  void record(int slot, uint32_t micros, int32_t heapDelta);
+
+  // Number of claimed slots
+  size_t size() const;
+
+  // Routes that couldn't be instrumented because the table was full
+  uint32_t getDroppedRegistrations() const {
+    return droppedRegistrations.load(std::memory_order_relaxed);
+  }
+
+  bool snapshot(size_t slot, Snapshot &out) const;
+
+  // Bumped by every record() and reset(); a slot whose changedAt is above a
+  // generation seen earlier has changed since
+  uint32_t getGeneration() const {
+    return generation.load(std::memory_order_acquire);
+  }
+
+  // Zero all counters, keeping the registered routes
+  void reset();
+
+  // Whether instrumented handlers record their heap delta. Without it the
+  // wrapper is two clock reads and the counters, and heapDelta* stay 0.
+  void setHeapDeltaEnabled(bool enabled) {
+    heapDeltaEnabled.store(enabled, std::memory_order_relaxed);
+  }
+  bool isHeapDeltaEnabled() const {
+    return heapDeltaEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Time the two freeHeap() reads a heap delta costs and enable it only if
+  // they fit budgetNanos. Returns the measured cost (see
+  // getHeapSampleNanos()).
+  uint32_t
+  calibrateHeapDelta(uint32_t budgetNanos = MAKER_API_HEAP_DELTA_BUDGET_NS);
+  uint32_t getHeapSampleNanos() const {
+    return heapSampleNanos.load(std::memory_order_relaxed);
+  }
+
+  // Monotonic clock and free heap used around instrumented handlers
+  static uint32_t nowMicros();
+  static uint32_t freeHeap();
+  static uint64_t uptimeMicros();
+
+private:
+  struct Slot {
+    std::atomic<bool> ready{false};
+    char module[kMaxModuleLength];
+    char path[kMaxPathLength];
+    char method[8];
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> totalMicros{0};
+    std::atomic<uint32_t> totalWraps{0}; // high word of totalMicros
+    std::atomic<uint32_t> minMicros{UINT32_MAX};
+    std::atomic<uint32_t> maxMicros{0};
+    std::atomic<int32_t> heapDeltaTotal{0};
+    std::atomic<int32_t> heapDeltaMax{INT32_MIN};
+    std::atomic<uint32_t> changedAt{0};
+    LatencyHistogram histogram;
+  };
+
+  IBufferAllocator *bufferAllocator = &SystemBufferAllocator::instance();
+  Slot *slots = nullptr; // kMaxRoutes, published by the first claim of used
+  std::atomic<uint32_t> used{0};
+  std::atomic<uint32_t> droppedRegistrations{0};
+  std::atomic<uint32_t> generation{0};
+  std::atomic<bool> heapDeltaEnabled{true};
+  std::atomic<uint32_t> heapSampleNanos{0};
+};
+
+// Main-loop timing: the gap between consecutive handle() calls, kept in a
+// ring of the most recent samples plus the longest gap since boot.
+// tick() is meant for the loop itself - a subtraction, a store and a compare
+// - so it is single-writer; readers on other tasks see each value atomically.
+class LoopTiming {
+public:
+  static constexpr size_t kSamples = 128; // Power of two
+
+  struct Summary {
+    uint32_t iterations;      // handle() calls since boot
+    size_t samples;           // gaps in the window
+    uint32_t periodMicros;    // mean gap over the window
+    uint32_t jitterMicros;    // standard deviation of the gap over the window
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint32_t longestMicros;   // longest gap since boot
+    uint32_t longestAtMillis; // uptime when it ended
+  };
+
+  void tick(uint32_t nowMicros) {
+    const uint32_t count = ticks.load(std::memory_order_relaxed);
+    if (count != 0) {
+      const uint32_t gap = nowMicros - last;
+      gaps[(count - 1) & (kSamples - 1)].store(gap, std::memory_order_relaxed);
+      if (gap > longest.load(std::memory_order_relaxed)) {
+        recordLongest(gap);
+      }
+    }
+    last = nowMicros;
+    ticks.store(count + 1, std::memory_order_release);
+  }
+
+  Summary summarize() const;
+
+  // Copy the window's gaps, oldest first. Returns how many were copied.
+  size_t copySamples(uint32_t *out, size_t max) const;
+
+private:
+  std::atomic<uint32_t> gaps[kSamples] = {};
+  std::atomic<uint32_t> ticks{0};
+  std::atomic<uint32_t> longest{0};
+  std::atomic<uint32_t> longestAt{0};
+  uint32_t last = 0;
+
+  void recordLongest(uint32_t gap);
+};
+
+#endif // MAKER_API_METRICS_H
@@ -0,0 +1,42 @@
+#ifndef MAKER_API_PROMETHEUS_H
+#define MAKER_API_PROMETHEUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_metrics.h"
+
+// Destination for Prometheus text output. The writer emits one line at a
+// time from a small stack buffer, so a sink backed by a streaming response
+// never needs the whole exposition in memory.
+class MetricsSink {
+public:
+  virtual ~MetricsSink() = default;
+  virtual void write(const char *data, size_t length) = 0;
+};
+
+// Writes metrics in the Prometheus text exposition format (version 0.0.4).
+// Metric names are prefixed with "makerapi_".
+class PrometheusWriter {
+public:
+  explicit PrometheusWriter(MetricsSink &sink) : sink(sink) {}
+
+  // Request counters, latency histograms (le at powers of two from 8us to
+  // ~33s) and heap deltas for every instrumented route that has seen traffic
+  void writeRouteMetrics(const RouteMetrics &metrics);
+
+  // Single-sample gauge/counter family with HELP and TYPE lines
+  void writeGauge(const char *name, const char *help, double value);
+  void writeCounter(const char *name, const char *help, uint32_t value);
+
+private:
+  MetricsSink &sink;
+
+  void writeHeader(const char *name, const char *help, const char *type);
+  void writeLine(const char *format, ...)
+      __attribute__((format(printf, 2, 3)));
+  void writeLabels(const RouteMetrics::Snapshot &snapshot, char *out,
+                   size_t size);
+};
+
+#endif // MAKER_API_PROMETHEUS_H
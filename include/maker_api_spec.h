@@ -0,0 +1,67 @@
+#ifndef MAKER_API_SPEC_H
+#define MAKER_API_SPEC_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <ArduinoFake.h>
+#endif
+
+#include <ArduinoJson.h>
+#include <vector>
+
+#include <web_platform_interface.h>
+
+class MakerAPIModule;
+
+// Builds the maker OpenAPI 3.0 document from modules' routes: every
+// documented ApiRoute tagged with one of the maker tags, or under /maker/.
+// Operations carry operationId, security, parameters, requestBody and the
+// response schema/example the dashboard reads. This is the module's own
+// generator, not the platform's: test_baked_spec_matches_runtime compares
+// it with a runtime spec captured from a device. The output only depends
+// on the routes, so a native host build can run it once and bake the
+// result into flash (see src/maker_api_bake_main.cpp and
+// MakerAPIModule::setBakedSpec()).
+class MakerSpecBuilder {
+public:
+  explicit MakerSpecBuilder(std::vector<String> tags = {"maker"});
+
+  // Add a module's routes as mounted at basePath (API routes are served
+  // under basePath + "/api")
+  void addRoutes(const String &basePath,
+                 const std::vector<RouteVariant> &routes);
+
+  // Define security schemes as a runtime spec captured from a device
+  // (GET /maker/openapi.json) does; the document then lists the ones its
+  // operations use under components.securitySchemes. Without this it only
+  // names them. False when the JSON has no securitySchemes.
+  bool adoptSecuritySchemes(const String &runtimeSpecJson);
+
+  size_t getOperationCount() const { return operationCount; }
+
+  // The document as minified JSON
+  String serialize(const String &title, const String &version) const;
+
+  // A header declaring json as a PROGMEM string named symbol
+  static String toHeader(const String &json, const char *symbol);
+
+private:
+  std::vector<String> tags;
+  JsonDocument paths;
+  JsonDocument securitySchemes; // Adopted from a runtime spec
+  JsonDocument usedSchemes;     // Names the operations use, in order
+  size_t operationCount = 0;
+
+  bool includes(const String &path, const OpenAPIDocumentation &docs) const;
+};
+
+// What the bake_native env documents (src/maker_api_bake_main.cpp). The
+// defaults add the explorer's own routes under module.getBasePath() with
+// the tags {"maker", "Maker API"}; an application bakes its own modules by
+// defining these in its bake sources, adding each module with the mount
+// point and tags it registers it with.
+void addBakedSpecRoutes(MakerSpecBuilder &builder, MakerAPIModule &module);
+std::vector<String> bakedSpecTags();
+
+#endif // MAKER_API_SPEC_H
@@ -0,0 +1,81 @@
+#ifndef MAKER_API_TRACE_H
+#define MAKER_API_TRACE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "maker_api_buffers.h"
+
+// Number of recent requests kept while tracing. Each slot is ~96 bytes,
+// allocated (in PSRAM when present) the first time tracing is enabled.
+#ifndef MAKER_API_TRACE_SLOTS
+#define MAKER_API_TRACE_SLOTS 32
+#endif
+
+// Ring of the most recent requests on instrumented routes, for export as a
+// Chrome trace. Off until enabled.
+//
+// Writers claim a ticket with one fetch_add and fill the ticket's slot under
+// a per-slot sequence lock (odd while writing), so capture never blocks or
+// allocates and works from any task. Readers skip slots that are mid-write
+// or were rewritten while being copied. A slot lapped by kSlots newer
+// requests while still being written can come out mixed - harmless for a
+// debugging trace.
+class RequestTrace {
+public:
+  static constexpr size_t kSlots = MAKER_API_TRACE_SLOTS;
+
+  struct Event {
+    char module[16];
+    char method[8];
+    char path[40];
+    uint64_t startMicros; // uptime
+    uint32_t durationMicros;
+    uint32_t bytes;  // response body
+    uint16_t status;
+    uint8_t core;    // CPU the handler ran on
+  };
+
+  RequestTrace() = default;
+  ~RequestTrace();
+  RequestTrace(const RequestTrace &) = delete;
+  RequestTrace &operator=(const RequestTrace &) = delete;
+
+  // Where the ring is allocated. Ignored once it is allocated.
+  void setBufferAllocator(IBufferAllocator &allocator) {
+    if (!slots.load(std::memory_order_relaxed)) {
+      bufferAllocator = &allocator;
+    }
+  }
+
+  // Enabling fails (returns false) when the ring can't be allocated
+  bool setEnabled(bool on);
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  void record(const Event &event);
+
+  // Copy the newest complete events (up to max), oldest first. Returns how
+  // many were copied.
+  size_t copy(Event *out, size_t max) const;
+
+  // Total events recorded (including those since overwritten)
+  uint32_t totalRecorded() const {
+    return next.load(std::memory_order_relaxed);
+  }
+
+  static uint8_t currentCore();
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence{0};
+    Event event;
+  };
+
+  IBufferAllocator *bufferAllocator = &SystemBufferAllocator::instance();
+  std::atomic<Slot *> slots{nullptr}; // kSlots; kept once allocated
+  std::atomic<uint32_t> next{0};
+  std::atomic<bool> enabled{false};
+};
+
+#endif // MAKER_API_TRACE_H
@@ -0,0 +1,108 @@
+"""PlatformIO extra_script: flash/RAM footprint report targets.
+
+Adds two custom targets that build the env and run tools/size_report.py
+over the resulting object files:
+
+    pio run -e esp32-s3-size -t size_report    # report + budget check
+    pio run -e esp32-s3-size -t size_baseline  # new baseline and budgets
+
+size_report prints flash/RAM per source file, each embedded asset and the
+largest symbols, diffs them against size_baseline.json (when present) and
+fails when a measured size_budget.json is exceeded. The report itself is
+written to $BUILD_DIR/size_report.json.
+
+An env that sets custom_size_link = yes links its sketch first, and the
+report adds the linked firmware's flash/RAM and takes the asset sizes from
+it. size_baseline saves the report as size_baseline.json and derives
+size_budget.json from it - commit both.
+
+Usage:
+    Add to platformio.ini: extra_scripts = post:scripts/size_report_target.py
+"""
+
+import glob
+import os
+import shutil
+import subprocess
+
+from SCons.Script import Import
+
+Import("env")
+
+project_dir = env["PROJECT_DIR"]
+budget_path = os.path.join(project_dir, "size_budget.json")
+baseline_path = os.path.join(project_dir, "size_baseline.json")
+report_path = os.path.join(env.subst("$BUILD_DIR"), "size_report.json")
+linked = env.GetProjectOption("custom_size_link", "no") == "yes"
+elf_path = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+
+
+def objdump_tool():
+    # Same toolchain as the compiler: xtensa-esp32s3-elf-gcc -> ...-objdump
+    cc = env.subst("$CC")
+    if cc.endswith("gcc"):
+        return cc[: -len("gcc")] + "objdump"
+    return "objdump"
+
+
+def run_report(target, source, env, extra_args=()):
+    objects = sorted(
+        glob.glob(os.path.join(env.subst("$BUILD_DIR"), "src", "**", "*.o"),
+                  recursive=True)
+    )
+    if not objects:
+        print("[size_report] ERROR: no object files - did the build run?")
+        return 1
+    return subprocess.call(
+        [
+            env.subst("$PYTHONEXE"),
+            os.path.join(project_dir, "tools", "size_report.py"),
+            "--objdump",
+            objdump_tool(),
+            "--budget",
+            budget_path,
+            "--baseline",
+            baseline_path,
+            "--output",
+            report_path,
+        ]
+        + (["--elf", elf_path] if linked else [])
+        + list(extra_args)
+        + objects,
+        env=env["ENV"],
+    )
+
+
+def save_baseline(target, source, env):
+    # The budgets follow the new baseline, so it's saved whatever the old
+    # budgets say
+    if os.path.exists(report_path):
+        os.remove(report_path)
+    run_report(target, source, env, ["--write-budget", budget_path])
+    if not os.path.exists(report_path):
+        return 1
+    shutil.copyfile(report_path, baseline_path)
+    print(f"[size_report] Saved {baseline_path} and {budget_path}")
+    return 0
+
+
+# Library-only envs have no sketch to link - depend on the compiled
+# sources there, on the firmware where there is one
+sources = ["$PROGPATH"] if linked else env.get("PIOBUILDFILES", [])
+
+env.AddCustomTarget(
+    name="size_report",
+    dependencies=sources,
+    actions=[run_report],
+    title="Size Report",
+    description="Flash/RAM per file, asset and symbol against size_budget.json",
+)
+
+env.AddCustomTarget(
+    name="size_baseline",
+    dependencies=sources,
+    actions=[save_baseline],
+    title="Size Baseline",
+    description="Save the size report as size_baseline.json and derive "
+    "size_budget.json from it",
+)
@@ -1,14 +1,35 @@
 #include "maker_api.h"
 #include <ArduinoJson.h>
+#include <algorithm>
+#include <string.h>
 
 #ifndef MAKER_API_STANDALONE_TEST
 #include "platform_provider.h"
 #endif
 
+
 // Include static assets
+#if !MAKER_API_HEADLESS
 #include "../assets/maker_api_dashboard_html.h"
+#include "../assets/maker_api_spec_worker_js.h"
 #include "../assets/maker_api_styles_css.h"
+#include "../assets/maker_api_sw_js.h"
 #include "../assets/maker_api_utils_js.h"
+#endif
+
+// Optional dashboard feature scripts (see MAKER_API_FEATURE_* in maker_api.h)
+#if MAKER_API_FEATURE_CODEGEN
+#include "../assets/maker_api_codegen_js.h"
+#endif
+#if MAKER_API_FEATURE_TOKENS
+#include "../assets/maker_api_tokens_js.h"
+#endif
+#if MAKER_API_FEATURE_LOAD_TEST
+#include "../assets/maker_api_load_test_js.h"
+#endif
+#if MAKER_API_FEATURE_BATCH
+#include "../assets/maker_api_batch_js.h"
+#endif
 
 // Global instance of MakerAPIModule
 // NOSONAR - This module instance must be mutable as it maintains state and
@@ -27,12 +48,414 @@ MakerAPIModule::MakerAPIModule(IWebPlatformProvider *provider)
 
 MakerAPIModule::~MakerAPIModule() = default;
 
+namespace {
+
+// Feature scripts compiled into this build, served as assets and listed in
+// /api/config so the dashboard loads exactly these. Ends with a null entry.
+struct FeatureAsset {
+  const char *name;
+  const char *path;
+  const char *content;
+};
+
+const FeatureAsset featureAssets[] = {
+#if MAKER_API_FEATURE_CODEGEN
+    {"codegen", "/assets/maker-api-codegen.js", MAKER_API_CODEGEN_JS},
+#endif
+#if MAKER_API_FEATURE_TOKENS
+    {"tokens", "/assets/maker-api-tokens.js", MAKER_API_TOKENS_JS},
+#endif
+#if MAKER_API_FEATURE_LOAD_TEST
+    {"load-test", "/assets/maker-api-load-test.js", MAKER_API_LOAD_TEST_JS},
+#endif
+#if MAKER_API_FEATURE_BATCH
+    {"batch", "/assets/maker-api-batch.js", MAKER_API_BATCH_JS},
+#endif
+    {nullptr, nullptr, nullptr}};
+
+// FNV-1a over a NUL-terminated (PROGMEM) string, continuing from hash
+uint32_t fnv1a(const char *data, uint32_t hash) {
+  for (const char *p = data; *p != '\0'; ++p) {
+    hash ^= static_cast<uint8_t>(*p);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const char *methodName(WebModule::Method method) {
+  switch (method) {
+  case WebModule::WM_GET:
+    return "GET";
+  case WebModule::WM_POST:
+    return "POST";
+  case WebModule::WM_PUT:
+    return "PUT";
+  case WebModule::WM_DELETE:
+    return "DELETE";
+  default:
+    return "OTHER";
+  }
+}
+
+// Histogram percentile, capped at the exact recorded maximum (bucket midpoints
+// can overshoot it)
+uint32_t percentileMicros(const RouteMetrics::Snapshot &snapshot,
+                          double percent) {
+  const uint32_t value = snapshot.histogram->percentile(percent);
+  return value < snapshot.maxMicros ? value : snapshot.maxMicros;
+}
+
+// Collects Prometheus output into a String response body. Once an append
+// fails (out of heap) the rest is dropped and failed() reports it, so a
+// truncated exposition is never served.
+class StringSink : public MetricsSink {
+public:
+  explicit StringSink(String &out) : out(out) {}
+  void write(const char *data, size_t length) override {
+    if (!failure && !out.concat(data, static_cast<unsigned int>(length))) {
+      failure = true;
+    }
+  }
+
+  bool failed() const { return failure; }
+
+private:
+  String &out;
+  bool failure = false;
+};
+
+bool hasAnyTag(const std::vector<String> &routeTags,
+               const std::vector<String> &tags) {
+  for (const String &tag : tags) {
+    for (const String &routeTag : routeTags) {
+      if (routeTag == tag) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Server-Timing header splitting a JSON route's time into building the
+// document (handler) and writing it out (serialize), in milliseconds
+void setServerTiming(ResponseT &res, uint32_t handlerMicros,
+                     uint32_t serializeMicros) {
+  char header[64];
+  snprintf(header, sizeof(header), "handler;dur=%.3f, serialize;dur=%.3f",
+           handlerMicros / 1000.0, serializeMicros / 1000.0);
+  res.setHeader("Server-Timing", header);
+}
+
+// One /api/metrics route entry (also pushed by the metrics stream)
+void addRouteJson(JsonArray routes, const RouteMetrics::Snapshot &snapshot) {
+  JsonObject route = routes.add<JsonObject>();
+  route["module"] = snapshot.module;
+  route["path"] = snapshot.path;
+  route["method"] = snapshot.method;
+  route["count"] = snapshot.count;
+  route["totalUs"] = snapshot.totalMicros;
+  route["avgUs"] = snapshot.count ? snapshot.totalMicros / snapshot.count : 0;
+  route["minUs"] = snapshot.minMicros;
+  route["maxUs"] = snapshot.maxMicros;
+  route["heapDeltaAvg"] =
+      snapshot.count
+          ? snapshot.heapDeltaTotal / static_cast<int32_t>(snapshot.count)
+          : 0;
+  route["heapDeltaMax"] = snapshot.heapDeltaMax;
+
+  if (snapshot.count == 0) {
+    return;
+  }
+  route["p50Us"] = percentileMicros(snapshot, 50);
+  route["p90Us"] = percentileMicros(snapshot, 90);
+  route["p99Us"] = percentileMicros(snapshot, 99);
+
+  JsonArray histogram = route["histogram"].to<JsonArray>();
+  for (size_t b = 0; b < LatencyHistogram::kBuckets; b++) {
+    const uint32_t count = snapshot.histogram->count(b);
+    if (count == 0) {
+      continue;
+    }
+    const uint32_t lower = LatencyHistogram::bucketLowerBound(b);
+    JsonArray bucket = histogram.add<JsonArray>();
+    bucket.add(lower);
+    bucket.add(lower + LatencyHistogram::bucketWidth(b));
+    bucket.add(count);
+  }
+  const uint32_t overflow =
+      snapshot.histogram->count(LatencyHistogram::kOverflowBucket);
+  if (overflow > 0) {
+    JsonArray bucket = histogram.add<JsonArray>();
+    bucket.add(LatencyHistogram::bucketLowerBound(
+        LatencyHistogram::kOverflowBucket));
+    bucket.add(nullptr); // No upper bound
+    bucket.add(overflow);
+  }
+}
+
+void addLoopJson(JsonObject out, const LoopTiming::Summary &summary) {
+  out["iterations"] = summary.iterations;
+  out["periodUs"] = summary.periodMicros;
+  out["jitterUs"] = summary.jitterMicros;
+  out["minUs"] = summary.minMicros;
+  out["maxUs"] = summary.maxMicros;
+  out["longestGapUs"] = summary.longestMicros;
+  out["longestGapAtMs"] = summary.longestAtMillis;
+  out["uptimeMs"] = static_cast<uint32_t>(RouteMetrics::uptimeMicros() / 1000);
+}
+
+void addHeapJson(JsonObject current, const HeapStats &stats) {
+  current["freeBytes"] = stats.freeBytes;
+  current["largestFreeBlock"] = stats.largestFreeBlock;
+  current["minFreeBytes"] = stats.minFreeBytes;
+  current["totalBytes"] = stats.totalBytes;
+  current["fragmentationPercent"] = stats.fragmentationPercent();
+  current["psramFreeBytes"] = stats.psramFreeBytes;
+  current["psramLargestFreeBlock"] = stats.psramLargestFreeBlock;
+  current["psramTotalBytes"] = stats.psramTotalBytes;
+}
+
+// [uptimeSeconds, freeBytes, largestFreeBlock, minFreeBytes, psramFreeBytes]
+void addHeapSampleJson(JsonArray entry, const HeapHistory::Sample &sample) {
+  entry.add(sample.uptimeSeconds);
+  entry.add(sample.freeBytes);
+  entry.add(sample.largestFreeBlock);
+  entry.add(sample.minFreeBytes);
+  entry.add(sample.psramFreeBytes);
+}
+
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+// A value a requested path gives one of its route's {name} segments
+struct PathParam {
+  String name;
+  String value;
+};
+
+size_t segmentLength(const char *segment) {
+  const char *end = strchr(segment, '/');
+  return end ? static_cast<size_t>(end - segment) : strlen(segment);
+}
+
+// How well a requested path names an instrumented route, segment by segment
+// with {name} segments matching any value: 4 for the route's own path, 3
+// for it with parameters filled in, 2 and 1 when the path only ends with
+// those (the full URL under a module prefix and /api), 0 for no match - so
+// a literal route beats a parameterized one. Fills params on a match.
+int pathMatchScore(const char *requested, const char *routePath,
+                   std::vector<PathParam> *params = nullptr) {
+  if (routePath[0] != '/') {
+    return 0;
+  }
+  size_t segments = 0;
+  for (const char *c = routePath; *c; c++) {
+    segments += *c == '/' ? 1 : 0;
+  }
+
+  // Start of the requested path's last `segments` segments
+  const char *tail = requested + strlen(requested);
+  size_t seen = 0;
+  while (tail > requested && seen < segments) {
+    seen += *--tail == '/' ? 1 : 0;
+  }
+  if (seen < segments || *tail != '/') {
+    return 0;
+  }
+
+  bool literal = true;
+  std::vector<PathParam> found;
+  for (const char *route = routePath, *path = tail; *route;) {
+    route++; // Both at a '/'
+    path++;
+    const size_t routeLength = segmentLength(route);
+    const size_t pathLength = segmentLength(path);
+    if (routeLength >= 2 && route[0] == '{' &&
+        route[routeLength - 1] == '}') {
+      if (pathLength == 0) {
+        return 0;
+      }
+      literal = false;
+      found.push_back({String(route + 1).substring(0, routeLength - 2),
+                       String(path).substring(0, pathLength)});
+    } else if (routeLength != pathLength ||
+               strncmp(route, path, routeLength) != 0) {
+      return 0;
+    }
+    route += routeLength;
+    path += pathLength;
+  }
+
+  if (params) {
+    *params = found;
+  }
+  return (tail == requested ? 3 : 1) + (literal ? 1 : 0);
+}
+
+// Batch and benchmark calls run with the caller's own authentication, but
+// the handler doesn't learn which of its accepted types (session, page
+// token, API token) that was. A call is only safe if its route is public or
+// accepts all of them.
+bool callerAuthCovers(
+    const decltype(WebRoute::authRequirements) &requirements) {
+  if (requirements.empty()) {
+    return true;
+  }
+  bool session = false;
+  bool pageToken = false;
+  bool token = false;
+  for (AuthType type : requirements) {
+    if (type == AuthType::NONE) {
+      return true;
+    }
+    session = session || type == AuthType::SESSION;
+    pageToken = pageToken || type == AuthType::PAGE_TOKEN;
+    token = token || type == AuthType::TOKEN;
+  }
+  return session && pageToken && token;
+}
+#endif
+
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+// Why a call's own headers can't be used, or nullptr if they can
+const char *checkCallHeaders(JsonVariant headers) {
+  if (headers.isNull()) {
+    return nullptr;
+  }
+  if (!headers.is<JsonObject>()) {
+    return "Headers must be an object";
+  }
+  for (JsonPair header : headers.as<JsonObject>()) {
+    if (!header.value().is<const char *>()) {
+      return "Header values must be strings";
+    }
+    const String name = header.key().c_str();
+    if (name.equalsIgnoreCase("Authorization") ||
+        name.equalsIgnoreCase("Cookie")) {
+      return "Calls run with the batch's authentication";
+    }
+  }
+  return nullptr;
+}
+#endif
+
+// Working copy for one request, allocated through the module's buffer
+// allocator and freed with the response - too large for the HTTP task's
+// stack, and one per request, so concurrent requests don't share it
+template <typename T> class ScratchBuffer {
+public:
+  ScratchBuffer(IBufferAllocator &allocator, size_t count)
+      : allocator(allocator), count(count),
+        items(allocateBuffer<T>(allocator, count,
+                                BufferPlacement::PreferPsram)) {}
+  ~ScratchBuffer() { freeBuffer(allocator, items, count); }
+  ScratchBuffer(const ScratchBuffer &) = delete;
+  ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+  T *get() const { return items; }
+
+private:
+  IBufferAllocator &allocator;
+  size_t count;
+  T *items;
+};
+
+} // namespace
+
+// Build a JSON response in the arena: the document lives only until it is
+// serialized, then the arena is reset for the next response
+template <typename Builder>
+void MakerAPIModule::sendJson(ResponseT &res, Builder build) const {
+  String body;
+  {
+    JsonArena::Lease lease(jsonArena);
+    JsonDocument doc(lease.allocator());
+    JsonObject root = doc.to<JsonObject>();
+    build(root);
+    body.reserve(measureJson(doc));
+    serializeJson(doc, body);
+  }
+  res.setContent(body, "application/json");
+}
+
 void MakerAPIModule::begin() {
-  // Nothing needed here - we're just serving UI assets
+  // Keep the per-request heap delta only where reading the free heap is
+  // cheap enough; getMetrics().setHeapDeltaEnabled() overrides this
+  metrics.calibrateHeapDelta();
+
+#if MAKER_API_HEADLESS
+  // Nothing in either body changes at runtime, so serialize them once
+  JsonDocument index;
+  JsonObject indexRoot = index.to<JsonObject>();
+  writeIndex(indexRoot);
+  cacheJson(index, indexResponse);
+
+  JsonDocument config;
+  JsonObject configRoot = config.to<JsonObject>();
+  writeOpenAPIConfig(configRoot);
+  cacheJson(config, configResponse);
+#else
+  // Fingerprint the embedded assets once so repeat visits can revalidate
+  // them (ETag) and the service worker can version its cache per build
+  const char *const assets[] = {MAKER_API_DASHBOARD_HTML, MAKER_API_STYLES_CSS,
+                                MAKER_API_UTILS_JS, MAKER_API_SPEC_WORKER_JS,
+                                MAKER_API_SW_JS};
+
+  uint32_t hash = 2166136261u;
+  for (const char *asset : assets) {
+    hash = fnv1a(asset, hash);
+  }
+  for (const FeatureAsset *feature = featureAssets; feature->name; ++feature) {
+    hash = fnv1a(feature->content, hash);
+  }
+
+  char version[9];
+  snprintf(version, sizeof(version), "%08lx", static_cast<unsigned long>(hash));
+  assetVersion = version;
+#endif
 }
 
+static_assert(MAKER_API_HEAP_SAMPLE_INTERVAL_MS < 4000000UL,
+              "Heap sample interval must fit the 32-bit microsecond clock");
+
 void MakerAPIModule::handle() {
-  // Nothing to do in regular processing
+  // Called once per webPlatform.handle(), so the gap between calls is the
+  // main loop's latency
+  const uint32_t now = RouteMetrics::nowMicros();
+  loopTiming.tick(now);
+
+  if (heapHistory.totalAdded() == 0 ||
+      now - lastHeapSampleMicros >=
+          MAKER_API_HEAP_SAMPLE_INTERVAL_MS * 1000UL) {
+    lastHeapSampleMicros = now;
+    sampleHeap();
+  }
+}
+
+void MakerAPIModule::setBufferAllocator(IBufferAllocator *allocator) {
+  IBufferAllocator &buffers =
+      allocator ? *allocator : SystemBufferAllocator::instance();
+  metrics.setBufferAllocator(buffers);
+  requestTrace.setBufferAllocator(buffers);
+  heapHistory.setBufferAllocator(buffers);
+  jsonArena.setBufferAllocator(buffers);
+  bufferAllocator = &buffers;
+}
+
+void MakerAPIModule::sendOutOfMemory(ResponseT &res) const {
+  res.setHeader("Retry-After", "10");
+  sendError(res, 503, "Not enough free heap for this request");
+}
+
+void MakerAPIModule::sampleHeap() {
+  const HeapStats stats = heapStats->read();
+
+  HeapHistory::Sample sample;
+  sample.uptimeSeconds =
+      static_cast<uint32_t>(RouteMetrics::uptimeMicros() / 1000000);
+  sample.freeBytes = stats.freeBytes;
+  sample.largestFreeBlock = stats.largestFreeBlock;
+  sample.minFreeBytes = stats.minFreeBytes;
+  sample.psramFreeBytes = stats.psramFreeBytes;
+  heapHistory.add(sample);
 }
 
 OpenAPIDocumentation MakerAPIModule::getOpenAPIConfigDocs() const {
@@ -42,6 +465,11 @@ OpenAPIDocumentation MakerAPIModule::getOpenAPIConfigDocs() const {
                                 "getOpenAPIConfig", {"Maker API"})
       .withResponseExample(R"({
         "success": true,
+        "assetVersion": "1a2b3c4d",
+        "features": {
+          "codegen": "/assets/maker-api-codegen.js",
+          "batch": "/assets/maker-api-batch.js"
+        },
         "OpenApiConfig": {
           "fullSpec": true,
           "makerSpec": true
@@ -51,12 +479,19 @@ OpenAPIDocumentation MakerAPIModule::getOpenAPIConfigDocs() const {
           "System OpenAPI configuration"));
 }
 
-void MakerAPIModule::getOpenAPIConfigHandler(RequestT &req,
-                                             ResponseT &res) const {
+void MakerAPIModule::writeOpenAPIConfig(JsonObject &root) const {
+  root["success"] = true;
+  if (assetVersion.length() > 0) {
+    root["assetVersion"] = assetVersion;
+  }
 
-  bool fullSpec = false;
-  bool makerSpec = false;
+  JsonObject features = root["features"].to<JsonObject>();
+  for (const FeatureAsset *feature = featureAssets; feature->name; ++feature) {
+    features[feature->name] = feature->path;
+  }
 
+  bool fullSpec = false;
+  bool makerSpec = bakedSpec != nullptr;
 #if OPENAPI_ENABLED
   fullSpec = true;
 #endif
@@ -64,21 +499,884 @@ void MakerAPIModule::getOpenAPIConfigHandler(RequestT &req,
   makerSpec = true;
 #endif
 
-  // Use JsonResponseBuilder for simple response
-  getPlatform().createJsonResponse(
+  JsonObject config = root["OpenApiConfig"].to<JsonObject>();
+  config["fullSpec"] = fullSpec;
+  config["makerSpec"] = makerSpec;
+
+  // Module-relative, like the feature script paths
+  if (bakedSpec) {
+    config["makerSpecUrl"] = "/openapi.json";
+  }
+}
+
+void MakerAPIModule::getOpenAPIConfigHandler(RequestT &req,
+                                             ResponseT &res) const {
+#if MAKER_API_HEADLESS
+  serveCached(req, res, configResponse);
+#else
+  const uint32_t start = RouteMetrics::nowMicros();
+  uint32_t handlerMicros = 0;
+
+  sendJson(
       res,
-      [fullSpec, makerSpec](
+      [this, &handlerMicros](
           JsonObject &root) { // NOSONAR - JsonObject must be non-const as we're
                               // modifying it by adding key-value pairs
+        const uint32_t buildStart = RouteMetrics::nowMicros();
+        writeOpenAPIConfig(root);
+        handlerMicros = RouteMetrics::nowMicros() - buildStart;
+      });
+
+  // Whatever sendJson spent outside the builder is serialization
+  const uint32_t totalMicros = RouteMetrics::nowMicros() - start;
+  setServerTiming(res, handlerMicros, totalMicros - handlerMicros);
+#endif
+}
+
+OpenAPIDocumentation MakerAPIModule::getMetricsDocs() const {
+  return OpenAPIFactory::create(
+             "Get route metrics",
+             "Per-route request count, latency (microseconds) and heap use "
+             "for instrumented routes since boot. histogram lists the "
+             "non-empty latency buckets as [lowerUs, upperUs, count], "
+             "upperUs null for values past the last bucket (~33s). "
+             "heapDelta says whether heap use is sampled - only when reading "
+             "the free heap twice (sampleNs) fits the per-request budget - "
+             "otherwise heapDeltaAvg/heapDeltaMax stay 0. jsonArena reports "
+             "the bytes JSON responses use in the per-request arena and how "
+             "often they fell back to the heap.",
+             "getRouteMetrics", {"Maker API"})
+      .withResponseExample(R"({
+        "success": true,
+        "capacity": 16,
+        "dropped": 0,
+        "heapDelta": {"enabled": true, "sampleNs": 180},
+        "routes": [
+          {
+            "module": "Maker API",
+            "path": "/config",
+            "method": "POST",
+            "count": 12,
+            "totalUs": 5400,
+            "avgUs": 450,
+            "minUs": 310,
+            "maxUs": 980,
+            "p50Us": 416,
+            "p90Us": 640,
+            "p99Us": 980,
+            "heapDeltaAvg": 0,
+            "heapDeltaMax": 128,
+            "histogram": [
+              [384, 448, 7], [448, 512, 3], [640, 768, 1], [896, 1024, 1]
+            ]
+          }
+        ],
+        "jsonArena": {
+          "capacity": 4096,
+          "highWater": 1184,
+          "lastUsed": 416,
+          "leases": 57,
+          "overflows": 0,
+          "contended": 0
+        }
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Route metrics"));
+}
+
+void MakerAPIModule::getMetricsHandler(RequestT &, ResponseT &res) const {
+  sendJson(
+      res, [this](JsonObject &root) { // NOSONAR - JsonObject must be non-const
+        root["success"] = true;
+        root["capacity"] = static_cast<uint32_t>(RouteMetrics::kMaxRoutes);
+        root["dropped"] = metrics.getDroppedRegistrations();
+
+        JsonObject heapDelta = root["heapDelta"].to<JsonObject>();
+        heapDelta["enabled"] = metrics.isHeapDeltaEnabled();
+        heapDelta["sampleNs"] = metrics.getHeapSampleNanos();
+
+        JsonArray routes = root["routes"].to<JsonArray>();
+        RouteMetrics::Snapshot snapshot;
+        for (size_t i = 0; i < metrics.size(); i++) {
+          if (metrics.snapshot(i, snapshot)) {
+            addRouteJson(routes, snapshot);
+          }
+        }
+
+        // As of the previous response - this one is still being built
+        const JsonArena::Stats arena = jsonArena.getStats();
+        JsonObject arenaJson = root["jsonArena"].to<JsonObject>();
+        arenaJson["capacity"] = arena.capacity;
+        arenaJson["highWater"] = arena.highWater;
+        arenaJson["lastUsed"] = arena.lastUsed;
+        arenaJson["leases"] = arena.leases;
+        arenaJson["overflows"] = arena.overflows;
+        arenaJson["contended"] = arena.contended;
+      });
+}
+
+OpenAPIDocumentation MakerAPIModule::getLoopTimingDocs() const {
+  return OpenAPIFactory::create(
+             "Get main loop timing",
+             "Gaps between main loop iterations (microseconds): the recent "
+             "window oldest first, its mean period, jitter (standard "
+             "deviation), min and max, and the longest gap since boot with "
+             "the uptime at which it ended.",
+             "getLoopTiming", {"Maker API"})
+      .withResponseExample(R"({
+        "success": true,
+        "iterations": 482113,
+        "periodUs": 10240,
+        "jitterUs": 380,
+        "minUs": 10011,
+        "maxUs": 14870,
+        "longestGapUs": 912004,
+        "longestGapAtMs": 5120,
+        "uptimeMs": 4930112,
+        "samples": [10102, 10230, 14870]
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Main loop timing"));
+}
+
+void MakerAPIModule::getLoopTimingHandler(RequestT &, ResponseT &res) const {
+  sendJson(
+      res, [this](JsonObject &root) { // NOSONAR - JsonObject must be non-const
+        root["success"] = true;
+        addLoopJson(root, loopTiming.summarize());
+
+        uint32_t samples[LoopTiming::kSamples];
+        const size_t count =
+            loopTiming.copySamples(samples, LoopTiming::kSamples);
+        JsonArray sampleArray = root["samples"].to<JsonArray>();
+        for (size_t i = 0; i < count; i++) {
+          sampleArray.add(samples[i]);
+        }
+      });
+}
+
+OpenAPIDocumentation MakerAPIModule::getHeapDocs() const {
+  return OpenAPIFactory::create(
+             "Get heap telemetry",
+             "Current heap statistics (bytes) with the fragmentation ratio "
+             "(percent of free heap unusable for one allocation that size), "
+             "and the sampled history, oldest first, as [uptimeSeconds, "
+             "freeBytes, largestFreeBlock, minFreeBytes, psramFreeBytes].",
+             "getHeapTelemetry", {"Maker API"})
+      .withResponseExample(R"({
+        "success": true,
+        "current": {
+          "freeBytes": 182340,
+          "largestFreeBlock": 110580,
+          "minFreeBytes": 151220,
+          "totalBytes": 327680,
+          "fragmentationPercent": 40,
+          "psramFreeBytes": 0,
+          "psramLargestFreeBlock": 0,
+          "psramTotalBytes": 0
+        },
+        "intervalMs": 60000,
+        "samples": [
+          [60, 183100, 110580, 151220, 0],
+          [120, 182340, 110580, 151220, 0]
+        ]
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Heap telemetry"));
+}
+
+void MakerAPIModule::getHeapHandler(RequestT &, ResponseT &res) const {
+  // Copied up front, so the history isn't locked while it's serialized
+  ScratchBuffer<HeapHistory::Sample> copy(*bufferAllocator,
+                                          HeapHistory::kSamples);
+  const HeapHistory::Sample *samples = copy.get();
+  if (!samples) {
+    sendOutOfMemory(res);
+    return;
+  }
+  const size_t count = heapHistory.copy(copy.get(), HeapHistory::kSamples);
+  const HeapStats stats = heapStats->read();
+
+  sendJson(
+      res, [&stats, samples, count](JsonObject &root) { // NOSONAR - JsonObject
+                                                        // must be non-const
+        root["success"] = true;
+
+        addHeapJson(root["current"].to<JsonObject>(), stats);
+        root["intervalMs"] = MAKER_API_HEAP_SAMPLE_INTERVAL_MS;
+
+        JsonArray history = root["samples"].to<JsonArray>();
+        for (size_t i = 0; i < count; i++) {
+          addHeapSampleJson(history.add<JsonArray>(), samples[i]);
+        }
+      });
+}
+
+OpenAPIDocumentation MakerAPIModule::getMetricsStreamDocs() const {
+  return OpenAPIFactory::create(
+             "Poll metric changes",
+             "Polling in Server-Sent Events format, not a held-open stream: "
+             "the platform sends whole responses, so each request gets at "
+             "most one event and closes with a retry interval, and "
+             "EventSource polls again after it with the Last-Event-ID it "
+             "was given. The "
+             "event holds only the routes (same fields as /api/metrics) that "
+             "changed since that ID, the loop timing summary, and the "
+             "current heap with its newest sample when a sample was taken. "
+             "Changes between reconnects are coalesced; when nothing "
+             "changed only the new ID is sent.",
+             "streamMetrics", {"Maker API"})
+      .withResponseExample(R"({
+        "routes": [
+          {"module": "Maker API", "path": "/config", "method": "POST",
+           "count": 13, "avgUs": 452}
+        ],
+        "loop": {"iterations": 482913, "periodUs": 10240, "jitterUs": 380},
+        "heap": {
+          "current": {"freeBytes": 182340, "largestFreeBlock": 110580},
+          "sample": [180, 182340, 110580, 151220, 0]
+        }
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Metric changes event"));
+}
+
+void MakerAPIModule::getMetricsStreamHandler(RequestT &req,
+                                             ResponseT &res) const {
+  res.setHeader("Cache-Control", "no-store");
+  res.setContent(getMetricsStreamEvent(req.getHeader("Last-Event-ID")),
+                 "text/event-stream");
+}
+
+String MakerAPIModule::getMetricsStreamEvent(const String &lastEventId) const {
+  // The event ID is "<route generation>-<heap samples taken>". No ID, or
+  // one from before a reboot, gets everything.
+  const uint32_t generation = metrics.getGeneration();
+  const uint32_t heapSamples = heapHistory.totalAdded();
+
+  unsigned long seenGeneration = 0;
+  unsigned long seenHeapSamples = 0;
+  const bool resumed = sscanf(lastEventId.c_str(), "%lu-%lu", &seenGeneration,
+                              &seenHeapSamples) == 2 &&
+                       seenGeneration <= generation &&
+                       seenHeapSamples <= heapSamples;
+  if (!resumed) {
+    seenGeneration = 0;
+    seenHeapSamples = 0;
+  }
+
+  bool routesChanged = !resumed;
+  RouteMetrics::Snapshot snapshot;
+  for (size_t i = 0; i < metrics.size() && !routesChanged; i++) {
+    routesChanged =
+        metrics.snapshot(i, snapshot) && snapshot.changedAt > seenGeneration;
+  }
+  const bool heapChanged = heapSamples != seenHeapSamples;
+
+  char fields[64];
+  snprintf(fields, sizeof(fields), "retry: %lu\nid: %lu-%lu\n",
+           static_cast<unsigned long>(metricsStreamIntervalMs),
+           static_cast<unsigned long>(generation),
+           static_cast<unsigned long>(heapSamples));
+  String body = fields;
+
+  if (routesChanged || heapChanged) {
+    // Built in the arena like sendJson(); only the event text is kept
+    String json;
+    {
+      JsonArena::Lease lease(jsonArena);
+      JsonDocument doc(lease.allocator());
+      JsonObject root = doc.to<JsonObject>();
+
+      JsonArray routes = root["routes"].to<JsonArray>();
+      for (size_t i = 0; i < metrics.size(); i++) {
+        if (metrics.snapshot(i, snapshot) &&
+            (!resumed || snapshot.changedAt > seenGeneration)) {
+          addRouteJson(routes, snapshot);
+        }
+      }
+
+      addLoopJson(root["loop"].to<JsonObject>(), loopTiming.summarize());
+
+      if (heapChanged) {
+        JsonObject heap = root["heap"].to<JsonObject>();
+        addHeapJson(heap["current"].to<JsonObject>(), heapStats->read());
+        HeapHistory::Sample newest;
+        if (heapHistory.copy(&newest, 1) == 1) {
+          addHeapSampleJson(heap["sample"].to<JsonArray>(), newest);
+        }
+      }
+
+      json.reserve(measureJson(doc));
+      serializeJson(doc, json);
+    }
+    body.reserve(body.length() + json.length() + 8);
+    body += "data: ";
+    body += json;
+    body += "\n";
+  }
+  body += "\n";
+  return body;
+}
+
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+int MakerAPIModule::findRouteTarget(const char *method, const char *path,
+                                    const char *module) const {
+  int best = -1;
+  int bestScore = 0;
+  bool ambiguous = false;
+
+  RouteMetrics::Snapshot snapshot;
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (!metrics.snapshot(i, snapshot) || !routeTargets[i].handler ||
+        strcmp(snapshot.method, method) != 0 ||
+        (module && strcmp(snapshot.module, module) != 0)) {
+      continue;
+    }
+    const int score = pathMatchScore(path, snapshot.path);
+    if (score > bestScore) {
+      best = static_cast<int>(i);
+      bestScore = score;
+      ambiguous = false;
+    } else if (score > 0 && score == bestScore) {
+      ambiguous = true;
+    }
+  }
+  return ambiguous ? -2 : best;
+}
+
+void MakerAPIModule::sendError(ResponseT &res, int status,
+                               const char *message) const {
+  sendJson(
+      res, [message](JsonObject &root) { // NOSONAR - JsonObject must be
+                                         // non-const
+        root["success"] = false;
+        root["error"] = message;
+      });
+  res.setStatus(status);
+}
+
+// The request a batch or benchmark call runs with: a copy of the caller's,
+// so it keeps that authentication and those headers, plus the call's own
+// headers, body and path parameters
+RequestT MakerAPIModule::callRequest(RequestT &req, JsonObject call, int slot,
+                                     const char *path) const {
+  RequestT callReq = req;
+
+  JsonVariant body = call["body"];
+  if (body.is<const char *>()) {
+    callReq.setBody(body.as<const char *>());
+  } else if (!body.isNull()) {
+    String json;
+    serializeJson(body, json);
+    callReq.setBody(json);
+  }
+
+  for (JsonPair header : call["headers"].as<JsonObject>()) {
+    callReq.setHeader(header.key().c_str(),
+                      header.value().as<const char *>());
+  }
+
+  RouteMetrics::Snapshot snapshot;
+  std::vector<PathParam> params;
+  if (metrics.snapshot(static_cast<size_t>(slot), snapshot) &&
+      pathMatchScore(path, snapshot.path, &params) > 0) {
+    for (const PathParam &param : params) {
+      callReq.setParam(param.name, param.value);
+    }
+  }
+  return callReq;
+}
+#endif
+
+#if MAKER_API_FEATURE_BATCH
+// The batch limit as text for the route docs
+#define MAKER_API_STRINGIFY_(value) #value
+#define MAKER_API_STRINGIFY(value) MAKER_API_STRINGIFY_(value)
+
+OpenAPIDocumentation MakerAPIModule::getBatchDocs() const {
+  return OpenAPIFactory::create(
+             "Run several API calls in one request",
+             "Takes a JSON array of calls ({method, path, module?, headers?, "
+             "body?}, at most " MAKER_API_STRINGIFY(
+                 MAKER_API_BATCH_MAX_CALLS) ") and runs each against the "
+             "instrumented route it names, in order, with this request's "
+             "authentication, returning every response in one payload. path "
+             "is the route's path, with any {parameters} filled in, or a full "
+             "URL ending with it; module disambiguates. Each call sees this "
+             "request's headers plus its own (string values; not "
+             "Authorization or Cookie) and its own body - an object or array "
+             "is sent as JSON. Query strings are rejected, as are routes that "
+             "don't accept all of session, page token and API token auth (or "
+             "none) - each with its own error status.",
+             "runBatch", {"Maker API"})
+      .withRequestExample(R"([
+        {"method": "GET", "path": "/api/metrics"},
+        {"method": "POST", "path": "/api/benchmark",
+         "headers": {"X-Request-Id": "42"},
+         "body": {"method": "GET", "path": "/api/heap", "iterations": 5}}
+      ])")
+      .withResponseExample(R"({
+        "success": true,
+        "responses": [
+          {"method": "GET", "path": "/api/metrics", "status": 200,
+           "durationUs": 1840, "body": {"success": true}},
+          {"method": "GET", "path": "/api/missing", "status": 404,
+           "durationUs": 0, "error": "No instrumented route matches"}
+        ]
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Batch responses"));
+}
+
+void MakerAPIModule::batchHandler(RequestT &req, ResponseT &res) const {
+  JsonDocument request;
+  if (deserializeJson(request, req.getBody()) || !request.is<JsonArray>()) {
+    sendError(res, 400, "Body must be a JSON array of calls");
+    return;
+  }
+  JsonArray calls = request.as<JsonArray>();
+  if (calls.size() > MAKER_API_BATCH_MAX_CALLS) {
+    sendError(res, 413, "Too many calls in one batch");
+    return;
+  }
+
+  // Run every call before building the reply - handlers build their own
+  // JSON responses through the platform
+  struct Result {
+    int status;
+    uint32_t micros;
+    const char *error;
+    String content;
+  };
+  std::vector<Result> results;
+  results.reserve(calls.size());
+
+  for (JsonObject call : calls) {
+    Result result = {0, 0, nullptr, String()};
+    const char *method = call["method"] | "GET";
+    const char *path = call["path"] | "";
+    const char *module = call["module"].as<const char *>(); // optional
+
+    const char *headerError = checkCallHeaders(call["headers"]);
+    int slot = -1;
+    if (headerError) {
+      result.status = 400;
+      result.error = headerError;
+    } else if (strchr(path, '?') != nullptr) {
+      result.status = 400;
+      result.error = "Query strings are not supported";
+    } else if ((slot = findRouteTarget(method, path, module)) == -2) {
+      result.status = 400;
+      result.error = "Path matches several routes - add module";
+    } else if (slot < 0) {
+      result.status = 404;
+      result.error = "No instrumented route matches";
+    } else if (!callerAuthCovers(routeTargets[slot].authRequirements)) {
+      result.status = 403;
+      result.error = "Route's authentication can't be checked in a batch";
+    } else {
+      RequestT callReq = callRequest(req, call, slot, path);
+      ResponseT callRes;
+      const uint32_t start = RouteMetrics::nowMicros();
+      routeTargets[slot].handler(callReq, callRes);
+      result.micros = RouteMetrics::nowMicros() - start;
+      result.status = callRes.getStatus();
+      result.content = callRes.getContent();
+    }
+    results.push_back(result);
+  }
+
+  sendJson(
+      res, [&calls, &results](JsonObject &root) { // NOSONAR - JsonObject must
+                                                  // be non-const
         root["success"] = true;
+        JsonArray responses = root["responses"].to<JsonArray>();
+
+        size_t i = 0;
+        for (JsonObject call : calls) {
+          const Result &result = results[i++];
+          JsonObject response = responses.add<JsonObject>();
+          response["method"] = call["method"] | "GET";
+          response["path"] = call["path"] | "";
+          response["status"] = result.status;
+          response["durationUs"] = result.micros;
+          if (result.error) {
+            response["error"] = result.error;
+            continue;
+          }
 
-        JsonObject config = root["OpenApiConfig"].to<JsonObject>();
-        config["fullSpec"] = fullSpec;
-        config["makerSpec"] = makerSpec;
+          // Embed JSON bodies as JSON, anything else as a string
+          JsonDocument body;
+          if (deserializeJson(body, result.content)) {
+            response["body"] = result.content;
+          } else {
+            response["body"] = body;
+          }
+        }
       });
 }
+#endif
+
+#if MAKER_API_FEATURE_LOAD_TEST
+OpenAPIDocumentation MakerAPIModule::getBenchmarkDocs() const {
+  return OpenAPIFactory::create(
+             "Benchmark a handler on the device",
+             "Runs an instrumented route's handler in-process, without the "
+             "network, for the requested iterations (at most 100, stopping "
+             "after 2s by default; 20 when omitted, fewer than 1 runs once) "
+             "and reports each iteration as [us, heapDelta, bytes] with a "
+             "summary. The route is named like a /api/batch call ({method, "
+             "path, module?, headers?, body?}) under the same rules: it runs "
+             "with this request's authentication plus the given headers, "
+             "body and path parameters, and must accept all of session, "
+             "page token and API token auth (or none). Runs are not counted "
+             "in the route metrics.",
+             "benchmarkHandler", {"Maker API"})
+      .withResponseExample(R"({
+        "success": true,
+        "route": {"module": "Maker API", "method": "GET", "path": "/heap"},
+        "summary": {
+          "iterations": 3,
+          "minUs": 812,
+          "maxUs": 1210,
+          "avgUs": 946,
+          "p50Us": 816,
+          "p90Us": 1210,
+          "heapDeltaMax": 0,
+          "bytes": 3120
+        },
+        "iterations": [[1210, 0, 3120], [816, 0, 3120], [812, 0, 3120]]
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Benchmark results"));
+}
+
+void MakerAPIModule::benchmarkHandler(RequestT &req, ResponseT &res) const {
+  JsonDocument request;
+  if (deserializeJson(request, req.getBody()) || !request.is<JsonObject>()) {
+    sendError(res, 400, "Body must be a JSON object naming a route");
+    return;
+  }
+  const char *method = request["method"] | "GET";
+  const char *path = request["path"] | "";
+  const char *module = request["module"].as<const char *>(); // optional
+
+  // Signed, so a negative count runs once instead of wrapping to the cap
+  const long requested = request["iterations"] | 20L;
+  const size_t iterations =
+      requested < 1 ? 1
+                    : static_cast<size_t>(std::min<long>(
+                          requested, HandlerBenchmark::kMaxIterations));
+
+  const char *headerError = checkCallHeaders(request["headers"]);
+  if (headerError) {
+    sendError(res, 400, headerError);
+    return;
+  }
+  if (strchr(path, '?') != nullptr) {
+    sendError(res, 400, "Query strings are not supported");
+    return;
+  }
+  const int slot = findRouteTarget(method, path, module);
+  if (slot == -2) {
+    sendError(res, 400, "Path matches several routes - add module");
+    return;
+  }
+  if (slot < 0) {
+    sendError(res, 404, "No instrumented route matches");
+    return;
+  }
+  if (!callerAuthCovers(routeTargets[slot].authRequirements)) {
+    sendError(res, 403, "Route's authentication can't be checked here");
+    return;
+  }
+
+  ScratchBuffer<HandlerBenchmark> run(*bufferAllocator, 1);
+  if (!run.get()) {
+    sendOutOfMemory(res);
+    return;
+  }
+  HandlerBenchmark &benchmark = *run.get();
+  const auto &handler = routeTargets[slot].unwrapped;
+  RequestT callReq = callRequest(req, request.as<JsonObject>(), slot, path);
+  benchmark.run(*heapStats, iterations, MAKER_API_BENCHMARK_BUDGET_MS * 1000UL,
+                [&handler, &callReq]() {
+                  ResponseT callRes;
+                  handler(callReq, callRes);
+                  return callRes.getContent().length();
+                });
+
+  RouteMetrics::Snapshot snapshot;
+  metrics.snapshot(static_cast<size_t>(slot), snapshot);
+  sendJson(
+      res, [&snapshot, &benchmark](JsonObject &root) { // NOSONAR - JsonObject
+                                                       // must be non-const
+        root["success"] = true;
+
+        JsonObject route = root["route"].to<JsonObject>();
+        route["module"] = snapshot.module;
+        route["method"] = snapshot.method;
+        route["path"] = snapshot.path;
+
+        const HandlerBenchmark::Summary summary = benchmark.summarize();
+        JsonObject stats = root["summary"].to<JsonObject>();
+        stats["iterations"] = static_cast<uint32_t>(summary.iterations);
+        stats["minUs"] = summary.minMicros;
+        stats["maxUs"] = summary.maxMicros;
+        stats["avgUs"] = summary.avgMicros;
+        stats["p50Us"] = summary.p50Micros;
+        stats["p90Us"] = summary.p90Micros;
+        stats["heapDeltaMax"] = summary.heapDeltaMax;
+        stats["bytes"] = summary.bytes;
+
+        JsonArray runs = root["iterations"].to<JsonArray>();
+        for (size_t i = 0; i < benchmark.size(); i++) {
+          const HandlerBenchmark::Iteration &iteration = benchmark.iteration(i);
+          JsonArray run = runs.add<JsonArray>();
+          run.add(iteration.micros);
+          run.add(iteration.heapDelta);
+          run.add(iteration.bytes);
+        }
+      });
+}
+#endif
+
+OpenAPIDocumentation MakerAPIModule::getTraceDocs() const {
+  return OpenAPIFactory::create(
+             "Get request trace",
+             "The most recent requests on instrumented routes as a Chrome "
+             "trace (open in Perfetto or chrome://tracing). One complete "
+             "event per request, timestamps in microseconds of uptime, one "
+             "track per CPU core. Empty unless tracing was enabled with "
+             "setRequestTracing(true).",
+             "getRequestTrace", {"Maker API"})
+      .withResponseExample(R"({
+        "traceEvents": [
+          {"name": "thread_name", "ph": "M", "pid": 1, "tid": 0,
+           "args": {"name": "core 0"}},
+          {"name": "POST /config", "cat": "Maker API", "ph": "X",
+           "ts": 4930112, "dur": 450, "pid": 1, "tid": 0,
+           "args": {"status": 200, "bytes": 96}}
+        ],
+        "displayTimeUnit": "ms",
+        "otherData": {"enabled": true, "capacity": 32, "recorded": 57}
+      })")
+      .withResponseSchema(
+          OpenAPIFactory::createSuccessResponse("Chrome trace events"));
+}
+
+void MakerAPIModule::getTraceHandler(RequestT &, ResponseT &res) const {
+  // Copied up front for the same reason as the heap history
+  ScratchBuffer<RequestTrace::Event> copy(*bufferAllocator,
+                                          RequestTrace::kSlots);
+  const RequestTrace::Event *events = copy.get();
+  if (!events) {
+    sendOutOfMemory(res);
+    return;
+  }
+  const size_t count = requestTrace.copy(copy.get(), RequestTrace::kSlots);
+
+  sendJson(
+      res, [this, events, count](JsonObject &root) { // NOSONAR - JsonObject
+                                                     // must be non-const
+        JsonArray traceEvents = root["traceEvents"].to<JsonArray>();
+
+        // Name the per-core tracks
+        bool coreSeen[2] = {false, false};
+        for (size_t i = 0; i < count; i++) {
+          const uint8_t core = events[i].core < 2 ? events[i].core : 1;
+          if (coreSeen[core]) {
+            continue;
+          }
+          coreSeen[core] = true;
+          JsonObject meta = traceEvents.add<JsonObject>();
+          meta["name"] = "thread_name";
+          meta["ph"] = "M";
+          meta["pid"] = 1;
+          meta["tid"] = core;
+          meta["args"]["name"] = core == 0 ? "core 0" : "core 1";
+        }
+
+        char name[sizeof(events[0].method) + sizeof(events[0].path) + 1];
+        for (size_t i = 0; i < count; i++) {
+          const RequestTrace::Event &event = events[i];
+          snprintf(name, sizeof(name), "%s %s", event.method, event.path);
+
+          JsonObject traceEvent = traceEvents.add<JsonObject>();
+          traceEvent["name"] = name;
+          traceEvent["cat"] = event.module;
+          traceEvent["ph"] = "X";
+          traceEvent["ts"] = event.startMicros;
+          traceEvent["dur"] = event.durationMicros;
+          traceEvent["pid"] = 1;
+          traceEvent["tid"] = event.core;
+          JsonObject args = traceEvent["args"].to<JsonObject>();
+          args["status"] = event.status;
+          args["bytes"] = event.bytes;
+        }
+
+        root["displayTimeUnit"] = "ms";
+        JsonObject other = root["otherData"].to<JsonObject>();
+        other["enabled"] = requestTrace.isEnabled();
+        other["capacity"] = static_cast<uint32_t>(RequestTrace::kSlots);
+        other["recorded"] = requestTrace.totalRecorded();
+      });
+}
+
+void MakerAPIModule::writePrometheusMetrics(MetricsSink &sink) const {
+  PrometheusWriter writer(sink);
+  writer.writeRouteMetrics(metrics);
+
+  const LoopTiming::Summary loop = loopTiming.summarize();
+  writer.writeCounter("makerapi_loop_iterations_total",
+                      "Main loop iterations (handle() calls).",
+                      loop.iterations);
+  writer.writeGauge("makerapi_loop_period_seconds",
+                    "Mean main loop period over the recent window.",
+                    loop.periodMicros / 1000000.0);
+  writer.writeGauge("makerapi_loop_jitter_seconds",
+                    "Standard deviation of the main loop period over the "
+                    "recent window.",
+                    loop.jitterMicros / 1000000.0);
+  writer.writeGauge("makerapi_loop_longest_gap_seconds",
+                    "Longest gap between main loop iterations since boot.",
+                    loop.longestMicros / 1000000.0);
+  const HeapStats heap = heapStats->read();
+  writer.writeGauge("makerapi_heap_free_bytes", "Free heap.", heap.freeBytes);
+  writer.writeGauge("makerapi_heap_largest_free_block_bytes",
+                    "Largest allocatable heap block.", heap.largestFreeBlock);
+  writer.writeGauge("makerapi_heap_min_free_bytes",
+                    "Lowest free heap since boot.", heap.minFreeBytes);
+  writer.writeGauge("makerapi_heap_fragmentation_ratio",
+                    "Share of free heap unusable for one allocation that "
+                    "size (1 - largest block / free).",
+                    heap.fragmentationPercent() / 100.0);
+  writer.writeGauge("makerapi_psram_free_bytes", "Free PSRAM.",
+                    heap.psramFreeBytes);
+  const JsonArena::Stats arena = jsonArena.getStats();
+  writer.writeGauge("makerapi_json_arena_capacity_bytes",
+                    "Size of the per-request JSON arena.", arena.capacity);
+  writer.writeGauge("makerapi_json_arena_high_water_bytes",
+                    "Most arena bytes one JSON response used.",
+                    arena.highWater);
+  writer.writeCounter("makerapi_json_arena_overflows_total",
+                      "JSON allocations that didn't fit the arena and went "
+                      "to the heap.",
+                      arena.overflows);
+  writer.writeCounter("makerapi_json_arena_contended_total",
+                      "JSON responses built on the heap because another "
+                      "response held the arena.",
+                      arena.contended);
+  writer.writeGauge("makerapi_uptime_seconds", "Time since boot.",
+                    RouteMetrics::uptimeMicros() / 1000000.0);
+}
+
+void MakerAPIModule::getPrometheusMetricsHandler(RequestT &,
+                                                 ResponseT &res) const {
+  // Each active route is ~30 lines of ~110 bytes. Reserve that up to
+  // MAKER_API_PROMETHEUS_RESERVE_BYTES; a reserve that fails is only a lost
+  // optimization, the appends below are what's checked.
+  size_t active = 0;
+  RouteMetrics::Snapshot snapshot;
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (metrics.snapshot(i, snapshot) && snapshot.count > 0) {
+      active++;
+    }
+  }
+
+  String body;
+  body.reserve(std::min<size_t>(1024 + active * 3400,
+                                MAKER_API_PROMETHEUS_RESERVE_BYTES));
+  StringSink sink(body);
+  writePrometheusMetrics(sink);
+
+  res.setHeader("Cache-Control", "no-store");
+  if (sink.failed()) {
+    body = String(); // Give the partial body back before replying
+    res.setStatus(503);
+    res.setHeader("Retry-After", "10");
+    res.setContent("Not enough free heap for the metrics exposition\n",
+                   "text/plain; charset=utf-8");
+    return;
+  }
+  res.setContent(body, "text/plain; version=0.0.4; charset=utf-8");
+}
+
+std::vector<RouteVariant>
+MakerAPIModule::instrumentRoutes(const String &moduleName,
+                                 std::vector<RouteVariant> routes,
+                                 const std::vector<String> &tags) {
+  for (RouteVariant &route : routes) {
+    if (route.isApiRoute()) {
+      ApiRoute apiRoute = route.getApiRoute();
+      if (!tags.empty() && !hasAnyTag(apiRoute.docs.getTags(), tags)) {
+        continue;
+      }
+      instrument(moduleName, apiRoute.webRoute);
+      route = apiRoute;
+    } else if (route.isWebRoute() && tags.empty()) {
+      WebRoute webRoute = route.getWebRoute();
+      instrument(moduleName, webRoute);
+      route = webRoute;
+    }
+  }
+  return routes;
+}
+
+void MakerAPIModule::instrument(const String &moduleName, WebRoute &route) {
+  const int slot = metrics.registerRoute(
+      moduleName.c_str(), route.path.c_str(), methodName(route.method));
+  if (slot < 0) {
+    return; // Table full - serve uninstrumented (counted as dropped)
+  }
+
+  // Names are filled in once here so tracing a request is a plain copy
+  RequestTrace::Event traced = {};
+  snprintf(traced.module, sizeof(traced.module), "%s", moduleName.c_str());
+  snprintf(traced.method, sizeof(traced.method), "%s",
+           methodName(route.method));
+  snprintf(traced.path, sizeof(traced.path), "%s", route.path.c_str());
+
+  auto handler = route.unifiedHandler;
+  RouteMetrics *table = &metrics;
+  RequestTrace *trace = &requestTrace;
+  route.unifiedHandler = [table, trace, slot, traced,
+                          handler](RequestT &req, ResponseT &res) {
+    const bool heapDelta = table->isHeapDeltaEnabled();
+    const uint32_t heapBefore = heapDelta ? RouteMetrics::freeHeap() : 0;
+    const bool tracing = trace->isEnabled();
+    const uint64_t startUptime = tracing ? RouteMetrics::uptimeMicros() : 0;
+    const uint32_t start = RouteMetrics::nowMicros();
+
+    handler(req, res);
+
+    const uint32_t elapsed = RouteMetrics::nowMicros() - start;
+    table->record(slot, elapsed,
+                  heapDelta ? static_cast<int32_t>(heapBefore -
+                                                   RouteMetrics::freeHeap())
+                            : 0);
+
+    if (tracing) {
+      RequestTrace::Event event = traced;
+      event.startMicros = startUptime;
+      event.durationMicros = elapsed;
+      event.status = static_cast<uint16_t>(res.getStatus());
+      event.bytes = res.getContent().length();
+      event.core = RequestTrace::currentCore();
+      trace->record(event);
+    }
+  };
+
+#if MAKER_API_FEATURE_BATCH || MAKER_API_FEATURE_LOAD_TEST
+  routeTargets[slot] = {route.unifiedHandler, handler, route.authRequirements};
+#endif
+}
 
 std::vector<RouteVariant> MakerAPIModule::getHttpRoutes() {
+#if MAKER_API_HEADLESS
+  return getHeadlessRoutes();
+#else
   std::vector<RouteVariant> routes;
 
   // Main dashboard routes
@@ -92,22 +1390,261 @@ std::vector<RouteVariant> MakerAPIModule::getHttpRoutes() {
   // Static assets
   routes.push_back(
       WebRoute("/assets/maker-api-style.css", WebModule::WM_GET,
-               [](RequestT &, ResponseT &res) {
-                 res.setProgmemContent(MAKER_API_STYLES_CSS, "text/css");
-                 res.setHeader("Cache-Control", "public, max-age=3600");
+               [this](RequestT &req, ResponseT &res) {
+                 serveAsset(req, res, MAKER_API_STYLES_CSS, "text/css");
                },
                {AuthType::NONE}));
 
   routes.push_back(
       WebRoute("/assets/maker-api-utils.js", WebModule::WM_GET,
+               [this](RequestT &req, ResponseT &res) {
+                 serveAsset(req, res, MAKER_API_UTILS_JS,
+                            "application/javascript; charset=utf-8");
+               },
+               {AuthType::NONE}));
+
+  // Spec fetch/parse worker - also loaded as a classic script when the
+  // browser has no Worker support
+  routes.push_back(
+      WebRoute("/assets/maker-api-spec-worker.js", WebModule::WM_GET,
+               [this](RequestT &req, ResponseT &res) {
+                 serveAsset(req, res, MAKER_API_SPEC_WORKER_JS,
+                            "application/javascript; charset=utf-8");
+               },
+               {AuthType::NONE}));
+
+  // Service worker - served from the module root so its default scope is the
+  // module prefix. Never cached by HTTP so firmware updates are picked up on
+  // the next visit.
+  routes.push_back(
+      WebRoute("/maker-api-sw.js", WebModule::WM_GET,
                [](RequestT &, ResponseT &res) {
-                 res.setProgmemContent(MAKER_API_UTILS_JS,
+                 res.setProgmemContent(MAKER_API_SW_JS,
                                        "application/javascript; charset=utf-8");
-                 res.setHeader("Cache-Control", "public, max-age=3600");
+                 res.setHeader("Cache-Control", "no-cache");
                },
                {AuthType::NONE}));
 
+  // API routes - recorded in this module's own metrics table
+  std::vector<RouteVariant> apiRoutes;
+
+  apiRoutes.push_back(ApiRoute(
+      "/config", WebModule::WM_POST,
+      [this](RequestT &req, ResponseT &res) {
+        getOpenAPIConfigHandler(req, res);
+      },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getOpenAPIConfigDocs())));
+
+  apiRoutes.push_back(ApiRoute(
+      "/metrics", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) { getMetricsHandler(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getMetricsDocs())));
+
+  apiRoutes.push_back(ApiRoute(
+      "/loop", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) {
+        getLoopTimingHandler(req, res);
+      },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getLoopTimingDocs())));
+
+  apiRoutes.push_back(ApiRoute(
+      "/heap", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) { getHeapHandler(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getHeapDocs())));
+
+  apiRoutes.push_back(ApiRoute(
+      "/trace", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) { getTraceHandler(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getTraceDocs())));
+
+  for (const RouteVariant &route :
+       instrumentRoutes(getModuleName(), apiRoutes)) {
+    routes.push_back(route);
+  }
+
+  // Not instrumented - every poll would otherwise be a change to push
   routes.push_back(ApiRoute(
+      "/metrics/stream", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) {
+        getMetricsStreamHandler(req, res);
+      },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getMetricsStreamDocs())));
+
+  // Batch and benchmark aren't instrumented either, so neither can dispatch
+  // to itself or the other. They accept exactly the auth types
+  // callerAuthCovers() checks their calls against.
+#if MAKER_API_FEATURE_BATCH
+  routes.push_back(ApiRoute(
+      "/batch", WebModule::WM_POST,
+      [this](RequestT &req, ResponseT &res) { batchHandler(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getBatchDocs())));
+#endif
+
+#if MAKER_API_FEATURE_LOAD_TEST
+  routes.push_back(ApiRoute(
+      "/benchmark", WebModule::WM_POST,
+      [this](RequestT &req, ResponseT &res) { benchmarkHandler(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
+      API_DOC_BLOCK(getBenchmarkDocs())));
+#endif
+
+  // Prometheus scrape endpoint - scrapers authenticate with a bearer token
+  routes.push_back(WebRoute(
+      "/metrics", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) {
+        getPrometheusMetricsHandler(req, res);
+      },
+      {AuthType::TOKEN, AuthType::SESSION}));
+
+  // Optional feature scripts (see featureAssets)
+  for (const FeatureAsset *feature = featureAssets; feature->name; ++feature) {
+    const char *content = feature->content;
+    routes.push_back(
+        WebRoute(feature->path, WebModule::WM_GET,
+                 [this, content](RequestT &req, ResponseT &res) {
+                   serveAsset(req, res, content,
+                              "application/javascript; charset=utf-8");
+                 },
+                 {AuthType::NONE}));
+  }
+
+  addBakedSpecRoute(routes);
+  return routes;
+#endif
+}
+
+void MakerAPIModule::setBakedSpec(const char *json) {
+  bakedSpec = json;
+  bakedSpecETag = "";
+  if (!json) {
+    return;
+  }
+
+  char etag[11];
+  snprintf(etag, sizeof(etag), "\"%08lx\"",
+           static_cast<unsigned long>(fnv1a(json, 2166136261u)));
+  bakedSpecETag = etag;
+}
+
+void MakerAPIModule::addBakedSpecRoute(std::vector<RouteVariant> &routes) {
+  if (!bakedSpec) {
+    return;
+  }
+
+  // Same auth as the API routes - the dashboard fetches it with the session
+  routes.push_back(WebRoute(
+      "/openapi.json", WebModule::WM_GET,
+      [this](RequestT &req, ResponseT &res) { serveBakedSpec(req, res); },
+      {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN}));
+}
+
+void MakerAPIModule::serveBakedSpec(RequestT &req, ResponseT &res) const {
+  // Revalidated on every load; unchanged until the next firmware build
+  res.setHeader("Cache-Control", "no-cache");
+  res.setHeader("ETag", bakedSpecETag);
+
+  if (req.getHeader("If-None-Match").indexOf(bakedSpecETag) >= 0) {
+    res.setStatus(304);
+    return;
+  }
+
+  res.setProgmemContent(bakedSpec, "application/json");
+}
+
+void MakerAPIModule::serveAsset(RequestT &req, ResponseT &res,
+                                const char *content,
+                                const char *mimeType) const {
+  res.setHeader("Cache-Control", "public, max-age=3600");
+
+  if (assetVersion.length() == 0) {
+    res.setProgmemContent(content, mimeType);
+    return;
+  }
+
+  String etag = "\"" + assetVersion + "\"";
+  res.setHeader("ETag", etag);
+
+  // Unchanged since the browser/service worker cached it
+  if (req.getHeader("If-None-Match").indexOf(assetVersion) >= 0) {
+    res.setStatus(304);
+    return;
+  }
+
+  res.setProgmemContent(content, mimeType);
+}
+
+#if MAKER_API_HEADLESS
+void MakerAPIModule::writeIndex(JsonObject &root) const {
+  root["name"] = getModuleName();
+  root["version"] = getModuleVersion();
+
+  // Absolute URLs: the platform serves its specs from the server root, the
+  // module everything else under its base path
+  JsonObject specs = root["specs"].to<JsonObject>();
+#if OPENAPI_ENABLED
+  specs["full"] = "/openapi.json";
+#endif
+#if MAKERAPI_ENABLED
+  specs["maker"] = "/maker/openapi.json";
+#endif
+  if (bakedSpec) {
+    specs["maker"] = basePath + "/openapi.json";
+  }
+
+  // The config route only answers POST
+  JsonObject config = root["config"].to<JsonObject>();
+  config["href"] = basePath + "/api/config";
+  config["method"] = "POST";
+}
+
+void MakerAPIModule::cacheJson(const JsonDocument &doc,
+                               CachedResponse &cached) {
+  cached.body = "";
+  serializeJson(doc, cached.body);
+
+  char etag[11];
+  snprintf(etag, sizeof(etag), "\"%08lx\"",
+           static_cast<unsigned long>(fnv1a(cached.body.c_str(), 2166136261u)));
+  cached.etag = etag;
+}
+
+void MakerAPIModule::serveCached(RequestT &req, ResponseT &res,
+                                 const CachedResponse &cached) const {
+  // Before begin() there is nothing to serve
+  if (cached.etag.length() == 0) {
+    res.setStatus(503);
+    return;
+  }
+
+  res.setHeader("Cache-Control", "no-cache");
+  res.setHeader("ETag", cached.etag);
+
+  if (req.getHeader("If-None-Match").indexOf(cached.etag) >= 0) {
+    res.setStatus(304);
+    return;
+  }
+
+  res.setContent(cached.body, "application/json");
+}
+
+std::vector<RouteVariant> MakerAPIModule::getHeadlessRoutes() {
+  std::vector<RouteVariant> routes;
+
+  routes.push_back(WebRoute("/", WebModule::WM_GET,
+                            [this](RequestT &req, ResponseT &res) {
+                              serveCached(req, res, indexResponse);
+                            },
+                            {AuthType::NONE}));
+
+  std::vector<RouteVariant> apiRoutes;
+  apiRoutes.push_back(ApiRoute(
       "/config", WebModule::WM_POST,
       [this](RequestT &req, ResponseT &res) {
         getOpenAPIConfigHandler(req, res);
@@ -115,8 +1652,15 @@ std::vector<RouteVariant> MakerAPIModule::getHttpRoutes() {
       {AuthType::SESSION, AuthType::PAGE_TOKEN, AuthType::TOKEN},
       API_DOC_BLOCK(getOpenAPIConfigDocs())));
 
+  for (const RouteVariant &route :
+       instrumentRoutes(getModuleName(), apiRoutes)) {
+    routes.push_back(route);
+  }
+
+  addBakedSpecRoute(routes);
   return routes;
 }
+#endif
 
 std::vector<RouteVariant> MakerAPIModule::getHttpsRoutes() {
   return getHttpRoutes();
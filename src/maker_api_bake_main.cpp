@@ -0,0 +1,91 @@
+// Bakes the maker OpenAPI spec into a PROGMEM header. Only compiled into
+// the bake_native env (MAKER_API_BAKE_MAIN), which registers modules on
+// the host exactly as the firmware would:
+//
+//   pio run -e bake_native -t exec
+//
+// Writes include/maker_api_baked_spec.h (or the path given as the first
+// argument). Re-run it whenever routes or their docs change, then serve
+// the result with
+//
+//   #include "maker_api_baked_spec.h"
+//   makerAPI.setBakedSpec(MAKER_API_BAKED_SPEC_JSON);
+//
+// A runtime spec saved from a device (GET /maker/openapi.json) as the
+// second argument supplies the security scheme definitions; without one
+// the spec only names the schemes its operations use.
+//
+// An application bakes its own routes from an env of its own: add
+// -DMAKER_API_BAKE_MAIN to a native env that depends on this library,
+// limit its build_src_filter to a file defining addBakedSpecRoutes() and
+// bakedSpecTags() (see maker_api_spec.h), and the definitions there replace
+// the defaults below.
+
+#if defined(NATIVE_PLATFORM) && defined(MAKER_API_BAKE_MAIN)
+
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <testing/testing_platform_provider.h>
+
+#include <maker_api.h>
+#include <maker_api_spec.h>
+
+__attribute__((weak)) void addBakedSpecRoutes(MakerSpecBuilder &builder,
+                                              MakerAPIModule &module) {
+  builder.addRoutes(module.getBasePath(), module.getHttpRoutes());
+}
+
+__attribute__((weak)) std::vector<String> bakedSpecTags() {
+  return {"maker", "Maker API"};
+}
+
+int main(int argc, char **argv) {
+  const char *outputPath =
+      argc > 1 ? argv[1] : "include/maker_api_baked_spec.h";
+  const char *runtimeSpecPath = argc > 2 ? argv[2] : nullptr;
+
+  MockWebPlatformProvider provider;
+  IWebPlatformProvider::instance = &provider;
+  MakerAPIModule module(&provider);
+  module.begin();
+
+  MakerSpecBuilder builder(bakedSpecTags());
+  if (runtimeSpecPath) {
+    std::ifstream in(runtimeSpecPath);
+    std::stringstream runtimeSpec;
+    runtimeSpec << in.rdbuf();
+    if (!in || !builder.adoptSecuritySchemes(runtimeSpec.str().c_str())) {
+      std::fprintf(stderr, "%s: no components.securitySchemes\n",
+                   runtimeSpecPath);
+      return 1;
+    }
+  }
+  addBakedSpecRoutes(builder, module);
+  const String json =
+      builder.serialize(module.getModuleName(), module.getModuleVersion());
+  const String header =
+      MakerSpecBuilder::toHeader(json, "MAKER_API_BAKED_SPEC_JSON");
+
+  FILE *out = std::fopen(outputPath, "w");
+  if (!out) {
+    std::perror(outputPath);
+    return 1;
+  }
+  std::fwrite(header.c_str(), 1, header.length(), out);
+  std::fclose(out);
+
+  std::printf("Baked %u operations (%u bytes) into %s\n",
+              static_cast<unsigned>(builder.getOperationCount()),
+              static_cast<unsigned>(json.length()), outputPath);
+
+  IWebPlatformProvider::instance = nullptr;
+  return 0;
+}
+
+#endif // NATIVE_PLATFORM && MAKER_API_BAKE_MAIN
@@ -0,0 +1,35 @@
+#include "maker_api_benchmark.h"
+
+#include <algorithm>
+
+HandlerBenchmark::Summary HandlerBenchmark::summarize() const {
+  Summary summary = {};
+  summary.iterations = count;
+  if (count == 0) {
+    return summary;
+  }
+
+  uint32_t sorted[kMaxIterations];
+  uint64_t total = 0;
+  summary.heapDeltaMax = results[0].heapDelta;
+  for (size_t i = 0; i < count; i++) {
+    sorted[i] = results[i].micros;
+    total += results[i].micros;
+    summary.heapDeltaMax = std::max(summary.heapDeltaMax, results[i].heapDelta);
+  }
+  std::sort(sorted, sorted + count);
+
+  // Nearest-rank percentiles
+  auto percentile = [&sorted, this](size_t percent) {
+    const size_t rank = (percent * count + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+  };
+
+  summary.minMicros = sorted[0];
+  summary.maxMicros = sorted[count - 1];
+  summary.avgMicros = static_cast<uint32_t>(total / count);
+  summary.p50Micros = percentile(50);
+  summary.p90Micros = percentile(90);
+  summary.bytes = results[count - 1].bytes;
+  return summary;
+}
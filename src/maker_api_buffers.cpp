@@ -0,0 +1,85 @@
+#include "maker_api_buffers.h"
+
+#include <stdlib.h>
+
+#ifndef NATIVE_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+void *SystemBufferAllocator::allocate(size_t size, BufferPlacement placement) {
+#ifdef NATIVE_PLATFORM
+  (void)placement;
+  return malloc(size);
+#else
+  if (placement == BufferPlacement::PreferPsram) {
+    // nullptr without PSRAM (or when it is full)
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr) {
+      return ptr;
+    }
+  }
+  return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#endif
+}
+
+void SystemBufferAllocator::deallocate(void *ptr) {
+#ifdef NATIVE_PLATFORM
+  free(ptr);
+#else
+  heap_caps_free(ptr);
+#endif
+}
+
+SystemBufferAllocator &SystemBufferAllocator::instance() {
+  static SystemBufferAllocator allocator;
+  return allocator;
+}
+
+void *FakeBufferAllocator::allocate(size_t size, BufferPlacement placement) {
+  if (failAll) {
+    return nullptr;
+  }
+  void *ptr = malloc(size ? size : 1);
+  if (!ptr) {
+    return nullptr;
+  }
+  const bool psram = placement == BufferPlacement::PreferPsram &&
+                     psramBytes() + size <= psramCapacity;
+  buffers.push_back({ptr, size, psram});
+  return ptr;
+}
+
+void FakeBufferAllocator::deallocate(void *ptr) {
+  for (size_t i = 0; i < buffers.size(); i++) {
+    if (buffers[i].ptr == ptr) {
+      buffers.erase(buffers.begin() + static_cast<long>(i));
+      free(ptr);
+      return;
+    }
+  }
+}
+
+size_t FakeBufferAllocator::psramBytes() const {
+  size_t total = 0;
+  for (const Buffer &buffer : buffers) {
+    total += buffer.psram ? buffer.size : 0;
+  }
+  return total;
+}
+
+size_t FakeBufferAllocator::internalBytes() const {
+  size_t total = 0;
+  for (const Buffer &buffer : buffers) {
+    total += buffer.psram ? 0 : buffer.size;
+  }
+  return total;
+}
+
+bool FakeBufferAllocator::inPsram(const void *ptr) const {
+  for (const Buffer &buffer : buffers) {
+    if (buffer.ptr == ptr) {
+      return buffer.psram;
+    }
+  }
+  return false;
+}
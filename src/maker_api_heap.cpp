@@ -0,0 +1,74 @@
+#include "maker_api_heap.h"
+
+#include <string.h>
+
+#ifndef NATIVE_PLATFORM
+#include <Arduino.h>
+#endif
+
+HeapStats SystemHeapStatsProvider::read() const {
+  HeapStats stats = {};
+#ifndef NATIVE_PLATFORM
+  stats.freeBytes = ESP.getFreeHeap();
+  stats.largestFreeBlock = ESP.getMaxAllocHeap();
+  stats.minFreeBytes = ESP.getMinFreeHeap();
+  stats.totalBytes = ESP.getHeapSize();
+  stats.psramFreeBytes = ESP.getFreePsram();
+  stats.psramLargestFreeBlock = ESP.getMaxAllocPsram();
+  stats.psramTotalBytes = ESP.getPsramSize();
+#endif
+  return stats;
+}
+
+HeapHistory::~HeapHistory() {
+  freeBuffer(*bufferAllocator, samples.load(std::memory_order_relaxed),
+             kSamples);
+}
+
+void HeapHistory::add(const Sample &sample) {
+  Sample *ring = samples.load(std::memory_order_relaxed);
+  if (!ring) {
+    ring = allocateBuffer<Sample>(*bufferAllocator, kSamples,
+                                  BufferPlacement::PreferPsram);
+    samples.store(ring, std::memory_order_release);
+  }
+
+  // Without a ring samples are only counted, so sampling keeps its pace
+  const uint32_t count = added.load(std::memory_order_relaxed);
+  if (!ring) {
+    added.store(count + 1, std::memory_order_release);
+    return;
+  }
+  ring[count % kSamples] = sample;
+  added.store(count + 1, std::memory_order_release);
+}
+
+size_t HeapHistory::copy(Sample *out, size_t max) const {
+  const uint32_t before = added.load(std::memory_order_acquire);
+  const Sample *ring = samples.load(std::memory_order_acquire);
+  if (!ring) {
+    return 0;
+  }
+  const size_t available = before < kSamples ? before : kSamples;
+  const size_t count = available < max ? available : max;
+  const uint32_t first = before - static_cast<uint32_t>(count);
+
+  for (size_t i = 0; i < count; i++) {
+    out[i] = ring[(first + i) % kSamples];
+  }
+
+  // Samples from `oldestIntact` on can't have been reused while copying
+  // (the writer may be mid-way through the slot of sample `after`)
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint32_t after = added.load(std::memory_order_relaxed);
+  const uint32_t oldestIntact =
+      after + 1 > kSamples ? after + 1 - static_cast<uint32_t>(kSamples) : 0;
+  if (oldestIntact <= first) {
+    return count;
+  }
+
+  const size_t torn =
+      oldestIntact - first < count ? oldestIntact - first : count;
+  memmove(out, out + torn, (count - torn) * sizeof(Sample));
+  return count - torn;
+}
@@ -0,0 +1,146 @@
+#include "maker_api_json_arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+// Blocks start with their size, padded so payloads stay aligned
+constexpr size_t kAlign = alignof(max_align_t);
+constexpr size_t kHeader = (sizeof(size_t) + kAlign - 1) & ~(kAlign - 1);
+
+size_t roundUp(size_t size) { return (size + kAlign - 1) & ~(kAlign - 1); }
+
+// Used while another response holds the arena
+class HeapAllocator : public ArduinoJson::Allocator {
+public:
+  void *allocate(size_t size) override { return malloc(size); }
+  void deallocate(void *ptr) override { free(ptr); }
+  void *reallocate(void *ptr, size_t newSize) override {
+    return realloc(ptr, newSize);
+  }
+};
+
+HeapAllocator heapAllocator;
+
+} // namespace
+
+JsonArena::Lease::Lease(JsonArena &arena) : arena(&arena) {
+  if (arena.busy.exchange(true, std::memory_order_acquire)) {
+    arena.contended.fetch_add(1, std::memory_order_relaxed);
+    this->arena = nullptr;
+    return;
+  }
+  // A failed allocation leaves the arena empty: everything overflows
+  if (!arena.buffer) {
+    arena.buffer = static_cast<uint8_t *>(arena.bufferAllocator->allocate(
+        arena.capacity, BufferPlacement::PreferPsram));
+  }
+  arena.leases++;
+}
+
+JsonArena::Lease::~Lease() {
+  if (arena) {
+    arena->reset();
+    arena->busy.store(false, std::memory_order_release);
+  }
+}
+
+ArduinoJson::Allocator *JsonArena::Lease::allocator() const {
+  if (arena) {
+    return arena;
+  }
+  return &heapAllocator;
+}
+
+JsonArena::~JsonArena() {
+  if (buffer) {
+    bufferAllocator->deallocate(buffer);
+  }
+}
+
+JsonArena::Stats JsonArena::getStats() const {
+  Stats stats;
+  stats.capacity = static_cast<uint32_t>(capacity);
+  stats.highWater = highWater;
+  stats.lastUsed = lastUsed;
+  stats.leases = leases;
+  stats.overflows = overflows;
+  stats.contended = contended.load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool JsonArena::owns(const void *ptr) const {
+  const uint8_t *p = static_cast<const uint8_t *>(ptr);
+  return buffer && p >= buffer && p < buffer + capacity;
+}
+
+void *JsonArena::allocate(size_t size) {
+  const size_t end = used + kHeader + roundUp(size);
+  if (!buffer || end > capacity) {
+    overflows++;
+    return malloc(size);
+  }
+
+  memcpy(buffer + used, &size, sizeof(size));
+  lastBlock = used;
+  hasLastBlock = true;
+  used = end;
+  if (used > peak) {
+    peak = used;
+  }
+  return buffer + lastBlock + kHeader;
+}
+
+void JsonArena::deallocate(void *ptr) {
+  if (!owns(ptr)) {
+    free(ptr);
+    return;
+  }
+  // Only the newest block can be handed back before the reset
+  if (hasLastBlock && ptr == buffer + lastBlock + kHeader) {
+    used = lastBlock;
+    hasLastBlock = false;
+  }
+}
+
+void *JsonArena::reallocate(void *ptr, size_t newSize) {
+  if (!ptr) {
+    return allocate(newSize);
+  }
+  if (!owns(ptr)) {
+    return realloc(ptr, newSize);
+  }
+
+  uint8_t *header = static_cast<uint8_t *>(ptr) - kHeader;
+
+  // Grow or shrink the newest block in place
+  if (hasLastBlock && header == buffer + lastBlock &&
+      lastBlock + kHeader + roundUp(newSize) <= capacity) {
+    memcpy(header, &newSize, sizeof(newSize));
+    used = lastBlock + kHeader + roundUp(newSize);
+    if (used > peak) {
+      peak = used;
+    }
+    return ptr;
+  }
+
+  size_t oldSize;
+  memcpy(&oldSize, header, sizeof(oldSize));
+  void *moved = allocate(newSize);
+  if (moved) {
+    memcpy(moved, ptr, oldSize < newSize ? oldSize : newSize);
+    deallocate(ptr);
+  }
+  return moved;
+}
+
+void JsonArena::reset() {
+  lastUsed = static_cast<uint32_t>(peak);
+  if (lastUsed > highWater) {
+    highWater = lastUsed;
+  }
+  used = 0;
+  peak = 0;
+  hasLastBlock = false;
+}
@@ -0,0 +1,346 @@
+#include "maker_api_metrics.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef NATIVE_PLATFORM
+#include <chrono>
+#else
+#include <Arduino.h>
+#include <esp_timer.h>
+#endif
+
+namespace {
+
+void copyName(char *dest, size_t size, const char *src) {
+  strncpy(dest, src ? src : "", size - 1);
+  dest[size - 1] = '\0';
+}
+
+bool sameName(const char *slotName, size_t size, const char *name) {
+  return strncmp(slotName, name ? name : "", size - 1) == 0;
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucketFor(uint32_t micros) {
+  if (micros < 2 * kSubBuckets) {
+    return micros; // Exact
+  }
+  if (micros >= (1u << kMaxExponent)) {
+    return kOverflowBucket;
+  }
+
+  const uint32_t exponent = 31 - __builtin_clz(micros);
+  const uint32_t subBucket =
+      (micros >> (exponent - kSubBucketBits)) - kSubBuckets;
+  return 2 * kSubBuckets + (exponent - kSubBucketBits - 1) * kSubBuckets +
+         subBucket;
+}
+
+uint32_t LatencyHistogram::bucketLowerBound(size_t bucket) {
+  if (bucket < 2 * kSubBuckets) {
+    return static_cast<uint32_t>(bucket);
+  }
+  const size_t offset = bucket - 2 * kSubBuckets;
+  const uint32_t exponent =
+      static_cast<uint32_t>(offset / kSubBuckets) + kSubBucketBits + 1;
+  const uint32_t subBucket = static_cast<uint32_t>(offset % kSubBuckets);
+  return (kSubBuckets + subBucket) << (exponent - kSubBucketBits);
+}
+
+uint32_t LatencyHistogram::bucketWidth(size_t bucket) {
+  if (bucket < 2 * kSubBuckets) {
+    return 1;
+  }
+  const uint32_t exponent = static_cast<uint32_t>(
+      (bucket - 2 * kSubBuckets) / kSubBuckets + kSubBucketBits + 1);
+  return 1u << (exponent - kSubBucketBits);
+}
+
+uint32_t LatencyHistogram::totalCount() const {
+  uint32_t total = 0;
+  for (const auto &bucketCount : counts) {
+    total += bucketCount.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+uint32_t LatencyHistogram::percentile(double percent) const {
+  // Copy once so the walk sees the same counts as the total
+  uint32_t snapshot[kBuckets + 1];
+  uint64_t total = 0;
+  for (size_t i = 0; i <= kOverflowBucket; i++) {
+    snapshot[i] = counts[i].load(std::memory_order_relaxed);
+    total += snapshot[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(percent / 100.0 * total + 0.999999);
+  if (rank < 1) {
+    rank = 1;
+  } else if (rank > total) {
+    rank = total;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; i++) {
+    seen += snapshot[i];
+    if (seen >= rank) {
+      return bucketLowerBound(i) + bucketWidth(i) / 2;
+    }
+  }
+  return UINT32_MAX; // In the overflow bucket
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucketCount : counts) {
+    bucketCount.store(0, std::memory_order_relaxed);
+  }
+}
+
+RouteMetrics::~RouteMetrics() {
+  freeBuffer(*bufferAllocator, slots, kMaxRoutes);
+}
+
+int RouteMetrics::registerRoute(const char *module, const char *path,
+                                const char *method) {
+  // Registration happens while routes are built, before any request
+  if (!slots) {
+    slots = allocateBuffer<Slot>(*bufferAllocator, kMaxRoutes,
+                                 BufferPlacement::Internal);
+    if (!slots) {
+      droppedRegistrations.fetch_add(1, std::memory_order_relaxed);
+      return -1;
+    }
+  }
+
+  const uint32_t claimed = used.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < claimed && i < kMaxRoutes; i++) {
+    const Slot &slot = slots[i];
+    if (slot.ready.load(std::memory_order_acquire) &&
+        sameName(slot.module, kMaxModuleLength, module) &&
+        sameName(slot.path, kMaxPathLength, path) &&
+        sameName(slot.method, sizeof(slot.method), method)) {
+      return static_cast<int>(i);
+    }
+  }
+
+  uint32_t index = used.load(std::memory_order_relaxed);
+  do {
+    if (index >= kMaxRoutes) {
+      droppedRegistrations.fetch_add(1, std::memory_order_relaxed);
+      return -1;
+    }
+  } while (!used.compare_exchange_weak(index, index + 1,
+                                       std::memory_order_acq_rel));
+
+  Slot &slot = slots[index];
+  copyName(slot.module, kMaxModuleLength, module);
+  copyName(slot.path, kMaxPathLength, path);
+  copyName(slot.method, sizeof(slot.method), method);
+  slot.ready.store(true, std::memory_order_release);
+
+  return static_cast<int>(index);
+}
+
+void RouteMetrics::record(int slot, uint32_t micros, int32_t heapDelta) {
+  if (slot < 0 || static_cast<size_t>(slot) >= size()) {
+    return;
+  }
+  Slot &s = slots[slot];
+
+  s.count.fetch_add(1, std::memory_order_relaxed);
+  s.histogram.record(micros);
+
+  const uint32_t previous =
+      s.totalMicros.fetch_add(micros, std::memory_order_relaxed);
+  if (previous > UINT32_MAX - micros) {
+    s.totalWraps.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint32_t current = s.minMicros.load(std::memory_order_relaxed);
+  while (micros < current &&
+         !s.minMicros.compare_exchange_weak(current, micros,
+                                            std::memory_order_relaxed)) {
+  }
+
+  current = s.maxMicros.load(std::memory_order_relaxed);
+  while (micros > current &&
+         !s.maxMicros.compare_exchange_weak(current, micros,
+                                            std::memory_order_relaxed)) {
+  }
+
+  s.heapDeltaTotal.fetch_add(heapDelta, std::memory_order_relaxed);
+
+  int32_t largest = s.heapDeltaMax.load(std::memory_order_relaxed);
+  while (heapDelta > largest &&
+         !s.heapDeltaMax.compare_exchange_weak(largest, heapDelta,
+                                               std::memory_order_relaxed)) {
+  }
+
+  s.changedAt.store(generation.fetch_add(1, std::memory_order_acq_rel) + 1,
+                    std::memory_order_release);
+}
+
+size_t RouteMetrics::size() const {
+  const uint32_t claimed = used.load(std::memory_order_acquire);
+  return claimed < kMaxRoutes ? claimed : kMaxRoutes;
+}
+
+bool RouteMetrics::snapshot(size_t slot, Snapshot &out) const {
+  if (slot >= size()) {
+    return false;
+  }
+  const Slot &s = slots[slot];
+  if (!s.ready.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  out.module = s.module;
+  out.path = s.path;
+  out.method = s.method;
+  out.count = s.count.load(std::memory_order_relaxed);
+  out.totalMicros =
+      (static_cast<uint64_t>(s.totalWraps.load(std::memory_order_relaxed))
+       << 32) |
+      s.totalMicros.load(std::memory_order_relaxed);
+  out.minMicros = out.count ? s.minMicros.load(std::memory_order_relaxed) : 0;
+  out.maxMicros = s.maxMicros.load(std::memory_order_relaxed);
+  out.heapDeltaTotal = s.heapDeltaTotal.load(std::memory_order_relaxed);
+  out.heapDeltaMax =
+      out.count ? s.heapDeltaMax.load(std::memory_order_relaxed) : 0;
+  out.changedAt = s.changedAt.load(std::memory_order_acquire);
+  out.histogram = &s.histogram;
+  return true;
+}
+
+void RouteMetrics::reset() {
+  const uint32_t resetAt =
+      generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+  const size_t claimed = size();
+  for (size_t i = 0; i < claimed; i++) {
+    Slot &s = slots[i];
+    s.count.store(0, std::memory_order_relaxed);
+    s.totalMicros.store(0, std::memory_order_relaxed);
+    s.totalWraps.store(0, std::memory_order_relaxed);
+    s.minMicros.store(UINT32_MAX, std::memory_order_relaxed);
+    s.maxMicros.store(0, std::memory_order_relaxed);
+    s.heapDeltaTotal.store(0, std::memory_order_relaxed);
+    s.heapDeltaMax.store(INT32_MIN, std::memory_order_relaxed);
+    s.histogram.reset();
+    s.changedAt.store(resetAt, std::memory_order_release);
+  }
+}
+
+void LoopTiming::recordLongest(uint32_t gap) {
+  longest.store(gap, std::memory_order_relaxed);
+  longestAt.store(static_cast<uint32_t>(RouteMetrics::uptimeMicros() / 1000),
+                  std::memory_order_relaxed);
+}
+
+LoopTiming::Summary LoopTiming::summarize() const {
+  Summary summary = {};
+  summary.iterations = ticks.load(std::memory_order_acquire);
+  summary.longestMicros = longest.load(std::memory_order_relaxed);
+  summary.longestAtMillis = longestAt.load(std::memory_order_relaxed);
+
+  uint32_t window[kSamples];
+  summary.samples = copySamples(window, kSamples);
+  if (summary.samples == 0) {
+    return summary;
+  }
+
+  uint64_t sum = 0;
+  summary.minMicros = UINT32_MAX;
+  for (size_t i = 0; i < summary.samples; i++) {
+    sum += window[i];
+    if (window[i] < summary.minMicros) {
+      summary.minMicros = window[i];
+    }
+    if (window[i] > summary.maxMicros) {
+      summary.maxMicros = window[i];
+    }
+  }
+  const double mean = static_cast<double>(sum) / summary.samples;
+
+  double variance = 0;
+  for (size_t i = 0; i < summary.samples; i++) {
+    const double deviation = window[i] - mean;
+    variance += deviation * deviation;
+  }
+  variance /= summary.samples;
+
+  summary.periodMicros = static_cast<uint32_t>(mean + 0.5);
+  summary.jitterMicros = static_cast<uint32_t>(sqrt(variance) + 0.5);
+  return summary;
+}
+
+size_t LoopTiming::copySamples(uint32_t *out, size_t max) const {
+  const uint32_t count = ticks.load(std::memory_order_acquire);
+  const size_t recorded = count > 0 ? count - 1 : 0;
+  const size_t available = recorded < kSamples ? recorded : kSamples;
+  const size_t copied = available < max ? available : max;
+
+  // Newest gap is at (recorded - 1); copy the last `copied` in order
+  for (size_t i = 0; i < copied; i++) {
+    const size_t index = (recorded - copied + i) & (kSamples - 1);
+    out[i] = gaps[index].load(std::memory_order_relaxed);
+  }
+  return copied;
+}
+
+// ArduinoFake's micros()/ESP are unstubbed mocks on native, so read the host
+// clock there and report no heap
+uint32_t RouteMetrics::calibrateHeapDelta(uint32_t budgetNanos) {
+  // Enough reads that the microsecond clock resolves their average
+  constexpr uint32_t kReads = 64;
+  volatile uint32_t sink = 0;
+  const uint64_t start = uptimeMicros();
+  for (uint32_t i = 0; i < kReads; i++) {
+    sink = sink + freeHeap();
+  }
+  const uint64_t elapsed = uptimeMicros() - start;
+  (void)sink;
+
+  const uint64_t pair = elapsed * 1000 * 2 / kReads;
+  const uint32_t nanos =
+      pair > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(pair);
+  heapSampleNanos.store(nanos, std::memory_order_relaxed);
+  setHeapDeltaEnabled(nanos <= budgetNanos);
+  return nanos;
+}
+
+uint32_t RouteMetrics::nowMicros() {
+#ifdef NATIVE_PLATFORM
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#else
+  return micros();
+#endif
+}
+
+uint32_t RouteMetrics::freeHeap() {
+#ifdef NATIVE_PLATFORM
+  return 0;
+#else
+  return ESP.getFreeHeap();
+#endif
+}
+
+// 64-bit, so unlike nowMicros() it doesn't wrap after ~71 minutes
+uint64_t RouteMetrics::uptimeMicros() {
+#ifdef NATIVE_PLATFORM
+  static const auto started = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - started)
+          .count());
+#else
+  return static_cast<uint64_t>(esp_timer_get_time());
+#endif
+}
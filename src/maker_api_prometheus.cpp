@@ -0,0 +1,146 @@
+#include "maker_api_prometheus.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace {
+
+constexpr uint32_t kFirstBoundExponent = 3; // le="0.000008"
+
+// Escape a label value (backslash, double quote, newline) into out
+size_t escapeLabel(const char *value, char *out, size_t size) {
+  size_t length = 0;
+  for (const char *p = value; *p != '\0' && length + 2 < size; ++p) {
+    if (*p == '\\' || *p == '"') {
+      out[length++] = '\\';
+      out[length++] = *p;
+    } else if (*p == '\n') {
+      out[length++] = '\\';
+      out[length++] = 'n';
+    } else {
+      out[length++] = *p;
+    }
+  }
+  out[length] = '\0';
+  return length;
+}
+
+// Microseconds as a decimal number of seconds, without floating point
+void formatSeconds(uint64_t micros, char *out, size_t size) {
+  snprintf(out, size, "%lu.%06lu",
+           static_cast<unsigned long>(micros / 1000000u),
+           static_cast<unsigned long>(micros % 1000000u));
+}
+
+} // namespace
+
+void PrometheusWriter::writeRouteMetrics(const RouteMetrics &metrics) {
+  char labels[192];
+  char seconds[24];
+  RouteMetrics::Snapshot snapshot;
+
+  writeHeader("makerapi_http_requests_total",
+              "Requests handled by instrumented routes.", "counter");
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (!metrics.snapshot(i, snapshot) || snapshot.count == 0) {
+      continue;
+    }
+    writeLabels(snapshot, labels, sizeof(labels));
+    writeLine("makerapi_http_requests_total{%s} %lu\n", labels,
+              static_cast<unsigned long>(snapshot.count));
+  }
+
+  writeHeader("makerapi_http_request_duration_seconds",
+              "Handler latency of instrumented routes.", "histogram");
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (!metrics.snapshot(i, snapshot) || snapshot.count == 0) {
+      continue;
+    }
+    writeLabels(snapshot, labels, sizeof(labels));
+
+    // Cumulative counts at each power-of-two bound; every histogram bucket
+    // below bucketFor(bound) ends at or before it, so the last finite bound
+    // (2^25us) takes every finite bucket and only the overflow bucket is
+    // left for +Inf
+    size_t bucket = 0;
+    uint64_t cumulative = 0;
+    for (uint32_t exponent = kFirstBoundExponent;
+         exponent <= LatencyHistogram::kMaxExponent; exponent++) {
+      const uint32_t bound = 1u << exponent;
+      const size_t end = LatencyHistogram::bucketFor(bound);
+      for (; bucket < end; bucket++) {
+        cumulative += snapshot.histogram->count(bucket);
+      }
+      formatSeconds(bound, seconds, sizeof(seconds));
+      writeLine("makerapi_http_request_duration_seconds_bucket{%s,le=\"%s\"} "
+                "%lu\n",
+                labels, seconds, static_cast<unsigned long>(cumulative));
+    }
+    cumulative +=
+        snapshot.histogram->count(LatencyHistogram::kOverflowBucket);
+    writeLine(
+        "makerapi_http_request_duration_seconds_bucket{%s,le=\"+Inf\"} %lu\n",
+        labels, static_cast<unsigned long>(cumulative));
+
+    formatSeconds(snapshot.totalMicros, seconds, sizeof(seconds));
+    writeLine("makerapi_http_request_duration_seconds_sum{%s} %s\n", labels,
+              seconds);
+    writeLine("makerapi_http_request_duration_seconds_count{%s} %lu\n", labels,
+              static_cast<unsigned long>(cumulative));
+  }
+
+  writeHeader("makerapi_http_request_heap_bytes_max",
+              "Largest free-heap drop across a single request.", "gauge");
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (!metrics.snapshot(i, snapshot) || snapshot.count == 0) {
+      continue;
+    }
+    writeLabels(snapshot, labels, sizeof(labels));
+    writeLine("makerapi_http_request_heap_bytes_max{%s} %ld\n", labels,
+              static_cast<long>(snapshot.heapDeltaMax));
+  }
+}
+
+void PrometheusWriter::writeGauge(const char *name, const char *help,
+                                  double value) {
+  writeHeader(name, help, "gauge");
+  writeLine("%s %.6f\n", name, value);
+}
+
+void PrometheusWriter::writeCounter(const char *name, const char *help,
+                                    uint32_t value) {
+  writeHeader(name, help, "counter");
+  writeLine("%s %lu\n", name, static_cast<unsigned long>(value));
+}
+
+void PrometheusWriter::writeHeader(const char *name, const char *help,
+                                   const char *type) {
+  writeLine("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void PrometheusWriter::writeLine(const char *format, ...) {
+  char line[320];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+
+  // Longer than any line written here - drop it rather than emit a
+  // cut-off sample
+  if (length < 0 || static_cast<size_t>(length) >= sizeof(line)) {
+    return;
+  }
+  sink.write(line, static_cast<size_t>(length));
+}
+
+void PrometheusWriter::writeLabels(const RouteMetrics::Snapshot &snapshot,
+                                   char *out, size_t size) {
+  char module[RouteMetrics::kMaxModuleLength * 2];
+  char path[RouteMetrics::kMaxPathLength * 2];
+  char method[16];
+  escapeLabel(snapshot.module, module, sizeof(module));
+  escapeLabel(snapshot.path, path, sizeof(path));
+  escapeLabel(snapshot.method, method, sizeof(method));
+  snprintf(out, size, "module=\"%s\",path=\"%s\",method=\"%s\"", module, path,
+           method);
+}
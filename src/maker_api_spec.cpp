@@ -0,0 +1,226 @@
+#include "maker_api_spec.h"
+
+#include <string.h>
+#include <utility>
+
+namespace {
+
+const char *operationMethod(WebModule::Method method) {
+  switch (method) {
+  case WebModule::WM_GET:
+    return "get";
+  case WebModule::WM_POST:
+    return "post";
+  case WebModule::WM_PUT:
+    return "put";
+  case WebModule::WM_DELETE:
+    return "delete";
+  default:
+    return nullptr;
+  }
+}
+
+// The security requirement an auth type is documented with. cookieAuth,
+// bearerAuth and localAuth are the names the dashboard reads from the
+// platform's runtime spec; pageTokenAuth is the dashboard's own name for
+// PAGE_TOKEN. What each scheme is, is left to adoptSecuritySchemes().
+const char *securityScheme(AuthType type) {
+  switch (type) {
+  case AuthType::SESSION:
+    return "cookieAuth";
+  case AuthType::PAGE_TOKEN:
+    return "pageTokenAuth";
+  case AuthType::TOKEN:
+    return "bearerAuth";
+  case AuthType::LOCAL_ONLY:
+    return "localAuth";
+  default:
+    return nullptr;
+  }
+}
+
+// Parse a JSON fragment from the docs (parameters, examples, schemas);
+// malformed fragments are left out rather than breaking the spec
+bool parseFragment(const String &json, JsonDocument &out) {
+  return json.length() > 0 && !deserializeJson(out, json);
+}
+
+} // namespace
+
+MakerSpecBuilder::MakerSpecBuilder(std::vector<String> tags)
+    : tags(std::move(tags)) {
+  paths.to<JsonObject>();
+  securitySchemes.to<JsonObject>();
+  usedSchemes.to<JsonArray>();
+}
+
+bool MakerSpecBuilder::adoptSecuritySchemes(const String &runtimeSpecJson) {
+  JsonDocument runtimeSpec;
+  if (deserializeJson(runtimeSpec, runtimeSpecJson)) {
+    return false;
+  }
+  JsonObjectConst schemes = runtimeSpec["components"]["securitySchemes"];
+  if (schemes.isNull()) {
+    return false;
+  }
+  securitySchemes.set(schemes);
+  return true;
+}
+
+bool MakerSpecBuilder::includes(const String &path,
+                                const OpenAPIDocumentation &docs) const {
+  if (path.startsWith("/maker/")) {
+    return true;
+  }
+  for (const String &routeTag : docs.getTags()) {
+    for (const String &tag : tags) {
+      if (routeTag == tag) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void MakerSpecBuilder::addRoutes(const String &basePath,
+                                 const std::vector<RouteVariant> &routes) {
+  for (const RouteVariant &route : routes) {
+    // Only API routes carry docs
+    if (!route.isApiRoute()) {
+      continue;
+    }
+    const ApiRoute &apiRoute = route.getApiRoute();
+    const WebRoute &webRoute = apiRoute.webRoute;
+    const char *method = operationMethod(webRoute.method);
+    if (!method || !includes(webRoute.path, apiRoute.docs)) {
+      continue;
+    }
+
+    const String path = basePath + "/api" + webRoute.path;
+    JsonObject pathItem = paths[path].as<JsonObject>();
+    if (pathItem.isNull()) {
+      pathItem = paths[path].to<JsonObject>();
+    }
+
+    JsonObject operation = pathItem[method].to<JsonObject>();
+    if (String(apiRoute.docs.operationId).length() > 0) {
+      operation["operationId"] = apiRoute.docs.operationId;
+    }
+    operation["summary"] = apiRoute.docs.getSummary();
+    operation["description"] = apiRoute.docs.getDescription();
+
+    JsonArray operationTags = operation["tags"].to<JsonArray>();
+    for (const String &tag : apiRoute.docs.getTags()) {
+      operationTags.add(tag);
+    }
+
+    // One alternative per accepted auth type; a public alternative is the
+    // empty requirement, and a public-only route has no security at all
+    bool secured = false;
+    for (AuthType type : webRoute.authRequirements) {
+      secured = secured || securityScheme(type) != nullptr;
+    }
+    if (secured) {
+      JsonArray security = operation["security"].to<JsonArray>();
+      for (AuthType type : webRoute.authRequirements) {
+        const char *scheme = securityScheme(type);
+        if (!scheme) {
+          security.add<JsonObject>();
+          continue;
+        }
+        security.add<JsonObject>()[scheme].to<JsonArray>();
+        bool listed = false;
+        for (JsonVariantConst used : usedSchemes.as<JsonArrayConst>()) {
+          listed = listed || strcmp(used | "", scheme) == 0;
+        }
+        if (!listed) {
+          usedSchemes.add(scheme);
+        }
+      }
+    }
+
+    JsonDocument parameters;
+    if (parseFragment(String(apiRoute.docs.parameters), parameters)) {
+      operation["parameters"] = parameters;
+    }
+
+    JsonDocument requestSchema;
+    JsonDocument requestExample;
+    const bool hasRequestSchema =
+        parseFragment(String(apiRoute.docs.requestSchema), requestSchema);
+    const bool hasRequestExample =
+        parseFragment(String(apiRoute.docs.requestExample), requestExample);
+    if (hasRequestSchema || hasRequestExample) {
+      JsonObject requestBody = operation["requestBody"].to<JsonObject>();
+      requestBody["required"] = true;
+      JsonObject content = requestBody["content"]["application/json"]
+                               .to<JsonObject>();
+      if (hasRequestSchema) {
+        content["schema"] = requestSchema;
+      }
+      if (hasRequestExample) {
+        content["example"] = requestExample;
+      }
+    }
+
+    JsonObject success = operation["responses"]["200"].to<JsonObject>();
+    success["description"] = "Success";
+    JsonDocument responseSchema;
+    JsonDocument responseExample;
+    const bool hasResponseSchema =
+        parseFragment(String(apiRoute.docs.responseSchema), responseSchema);
+    const bool hasResponseExample =
+        parseFragment(String(apiRoute.docs.responseExample), responseExample);
+    if (hasResponseSchema || hasResponseExample) {
+      JsonObject content =
+          success["content"]["application/json"].to<JsonObject>();
+      if (hasResponseSchema) {
+        content["schema"] = responseSchema;
+      }
+      if (hasResponseExample) {
+        content["example"] = responseExample;
+      }
+    }
+
+    operationCount++;
+  }
+}
+
+String MakerSpecBuilder::serialize(const String &title,
+                                   const String &version) const {
+  JsonDocument doc;
+  doc["openapi"] = "3.0.3";
+  doc["info"]["title"] = title;
+  doc["info"]["version"] = version;
+  doc["paths"] = paths.as<JsonObjectConst>();
+  // Only the adopted definitions the operations use
+  for (JsonVariantConst used : usedSchemes.as<JsonArrayConst>()) {
+    const char *name = used | "";
+    JsonVariantConst scheme = securitySchemes[name];
+    if (!scheme.isNull()) {
+      doc["components"]["securitySchemes"][name] = scheme;
+    }
+  }
+
+  String json;
+  serializeJson(doc, json);
+  return json;
+}
+
+String MakerSpecBuilder::toHeader(const String &json, const char *symbol) {
+  String header;
+  header.reserve(json.length() + 256);
+  header += "// Generated by the bake_native env - DO NOT EDIT BY HAND\n";
+  header += "#ifndef ";
+  header += symbol;
+  header += "_H\n#define ";
+  header += symbol;
+  header += "_H\n\n#include <Arduino.h>\n\nconst char ";
+  header += symbol;
+  header += "[] PROGMEM = R\"makerapi(";
+  header += json;
+  header += ")makerapi\";\n\n#endif // ";
+  header += symbol;
+  header += "_H\n";
+  return header;
+}
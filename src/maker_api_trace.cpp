@@ -0,0 +1,83 @@
+#include "maker_api_trace.h"
+
+#include <string.h>
+
+#ifndef NATIVE_PLATFORM
+#include <Arduino.h>
+#endif
+
+// Sequence values are 2 * ticket + 1 while ticket's event is being written
+// and 2 * ticket + 2 once it is complete, so a reader can tell both "in
+// progress" and "not the event I expected" from one load.
+
+RequestTrace::~RequestTrace() {
+  freeBuffer(*bufferAllocator, slots.load(std::memory_order_relaxed), kSlots);
+}
+
+bool RequestTrace::setEnabled(bool on) {
+  // Allocated from the loop task; never freed while requests may record, so
+  // disabling keeps the ring (and its events)
+  if (on && !slots.load(std::memory_order_relaxed)) {
+    Slot *ring = allocateBuffer<Slot>(*bufferAllocator, kSlots,
+                                      BufferPlacement::PreferPsram);
+    if (!ring) {
+      return false;
+    }
+    slots.store(ring, std::memory_order_release);
+  }
+  enabled.store(on, std::memory_order_relaxed);
+  return true;
+}
+
+void RequestTrace::record(const Event &event) {
+  Slot *ring = slots.load(std::memory_order_acquire);
+  if (!ring) {
+    return;
+  }
+  const uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = ring[ticket % kSlots];
+
+  slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  memcpy(&slot.event, &event, sizeof(Event));
+
+  slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+size_t RequestTrace::copy(Event *out, size_t max) const {
+  const Slot *ring = slots.load(std::memory_order_acquire);
+  if (!ring) {
+    return 0;
+  }
+  const uint32_t end = next.load(std::memory_order_acquire);
+  const size_t window = max < kSlots ? max : kSlots;
+  const uint32_t start = end > window ? end - static_cast<uint32_t>(window) : 0;
+
+  size_t copied = 0;
+  for (uint32_t ticket = start; ticket != end; ticket++) {
+    const Slot &slot = ring[ticket % kSlots];
+
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != 2 * ticket + 2) {
+      continue; // Still being written, or already reused
+    }
+
+    memcpy(&out[copied], &slot.event, sizeof(Event));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+      continue; // Rewritten while we copied
+    }
+    copied++;
+  }
+  return copied;
+}
+
+uint8_t RequestTrace::currentCore() {
+#ifdef NATIVE_PLATFORM
+  return 0;
+#else
+  return static_cast<uint8_t>(xPortGetCoreID());
+#endif
+}
@@ -0,0 +1,78 @@
+#ifndef MAKER_API_ALLOC_BUDGETS_H
+#define MAKER_API_ALLOC_BUDGETS_H
+
+#include <stddef.h>
+
+#include "../../../assets/maker_api_batch_js.h"
+#include "../../../assets/maker_api_codegen_js.h"
+#include "../../../assets/maker_api_dashboard_html.h"
+#include "../../../assets/maker_api_load_test_js.h"
+#include "../../../assets/maker_api_spec_worker_js.h"
+#include "../../../assets/maker_api_styles_css.h"
+#include "../../../assets/maker_api_sw_js.h"
+#include "../../../assets/maker_api_tokens_js.h"
+#include "../../../assets/maker_api_utils_js.h"
+
+// Heap budgets checked by test_allocation_budgets: route construction and
+// one call of every route handler (named "<METHOD> <path>", API routes under
+// /api), on the native mock platform with an idle module. Each entry is the
+// allocation count and peak bytes measured there; the test allows
+// MAKER_API_ALLOC_MARGIN over them (an eighth, plus 2 allocations and 256
+// bytes, for allocator differences between hosts). It prints every
+// measurement as
+//   ALLOC_MEASURED "<name>" <allocations> <peakBytes>
+// and the literal entries below are rewritten from that output by
+//   pio test -e test_native -v | python3 tools/update_alloc_budgets.py
+// A change that needs more must update its entry - and a new route needs one.
+//
+// The literal entries below are placeholders until that command has been
+// run on a glibc host: while MAKER_API_ALLOC_BUDGETS_MEASURED is 0 the test
+// prints the measurements and is reported as ignored instead of checking
+// them. The script sets it to 1 once every literal entry is measured.
+#define MAKER_API_ALLOC_BUDGETS_MEASURED 0
+
+struct AllocBudget {
+  const char *name;
+  size_t allocations;
+  size_t peakBytes;
+};
+
+#define MAKER_API_ALLOC_MARGIN(measured, slack)                                \
+  ((measured) + (measured) / 8 + (slack))
+
+// Assets may be copied into the response body on native builds, so they
+// follow the asset size and aren't rewritten
+#define MAKER_API_ASSET_BUDGET(asset) 2, sizeof(asset)
+
+static const AllocBudget kAllocBudgets[] = {
+    {"getHttpRoutes", 512, 32768},
+    {"GET /", MAKER_API_ASSET_BUDGET(MAKER_API_DASHBOARD_HTML)},
+    {"GET /assets/maker-api-style.css",
+     MAKER_API_ASSET_BUDGET(MAKER_API_STYLES_CSS)},
+    {"GET /assets/maker-api-utils.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_UTILS_JS)},
+    {"GET /assets/maker-api-spec-worker.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_SPEC_WORKER_JS)},
+    {"GET /maker-api-sw.js", MAKER_API_ASSET_BUDGET(MAKER_API_SW_JS)},
+    {"POST /api/config", 12, 10240},
+    {"GET /api/metrics", 6, 6144},
+    {"GET /api/loop", 6, 3072},
+    {"GET /api/heap", 6, 2048},
+    {"GET /api/trace", 6, 1024},
+    {"GET /api/metrics/stream", 8, 6144},
+    {"POST /api/batch", 4, 512},
+    {"POST /api/benchmark", 4, 512},
+    {"GET /metrics", 24, 12288},
+    {"GET /assets/maker-api-codegen.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_CODEGEN_JS)},
+    {"GET /assets/maker-api-tokens.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_TOKENS_JS)},
+    {"GET /assets/maker-api-load-test.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_LOAD_TEST_JS)},
+    {"GET /assets/maker-api-batch.js",
+     MAKER_API_ASSET_BUDGET(MAKER_API_BATCH_JS)},
+};
+
+#undef MAKER_API_ASSET_BUDGET
+
+#endif // MAKER_API_ALLOC_BUDGETS_H
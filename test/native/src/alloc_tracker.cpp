@@ -0,0 +1,108 @@
+#include "alloc_tracker.h"
+
+#include <new>
+#include <stdlib.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+bool tracking = false;
+size_t allocations = 0;
+size_t allocatedBytes = 0;
+long long liveBytes = 0; // Can go negative: frees of older blocks
+long long peakBytes = 0;
+
+void noteAlloc(void *ptr) {
+  if (!tracking || ptr == nullptr) {
+    return;
+  }
+  const size_t size = malloc_usable_size(ptr);
+  allocations++;
+  allocatedBytes += size;
+  liveBytes += static_cast<long long>(size);
+  if (liveBytes > peakBytes) {
+    peakBytes = liveBytes;
+  }
+}
+
+void noteFree(void *ptr) {
+  if (tracking && ptr != nullptr) {
+    liveBytes -= static_cast<long long>(malloc_usable_size(ptr));
+  }
+}
+
+} // namespace
+
+extern "C" void *malloc(size_t size) {
+  void *ptr = __libc_malloc(size);
+  noteAlloc(ptr);
+  return ptr;
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+  void *ptr = __libc_calloc(count, size);
+  noteAlloc(ptr);
+  return ptr;
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+  noteFree(ptr);
+  void *moved = __libc_realloc(ptr, size);
+  // On failure the old block is still held
+  noteAlloc(moved != nullptr || size == 0 ? moved : ptr);
+  return moved;
+}
+
+extern "C" void free(void *ptr) {
+  noteFree(ptr);
+  __libc_free(ptr);
+}
+
+AllocScope::AllocScope() {
+  allocations = 0;
+  allocatedBytes = 0;
+  liveBytes = 0;
+  peakBytes = 0;
+  tracking = true;
+}
+
+AllocScope::~AllocScope() { tracking = false; }
+
+AllocStats AllocScope::stats() const {
+  return {allocations, allocatedBytes, static_cast<size_t>(peakBytes)};
+}
+
+bool AllocScope::supported() { return true; }
+
+#else
+
+AllocScope::AllocScope() {}
+AllocScope::~AllocScope() {}
+AllocStats AllocScope::stats() const { return {0, 0, 0}; }
+bool AllocScope::supported() { return false; }
+
+#endif
+
+// Route operator new/delete through malloc/free so they are counted the same
+// way whatever the C++ runtime does internally
+void *operator new(size_t size) {
+  if (void *ptr = malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
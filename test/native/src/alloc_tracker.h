@@ -0,0 +1,28 @@
+#ifndef MAKER_API_ALLOC_TRACKER_H
+#define MAKER_API_ALLOC_TRACKER_H
+
+#include <stddef.h>
+
+struct AllocStats {
+  size_t allocations; // malloc/calloc/realloc/operator new calls
+  size_t bytes;       // total allocated (usable size)
+  size_t peakBytes;   // most held at once above the scope's starting point
+};
+
+// Counts heap allocations made while it is alive. malloc, calloc and realloc
+// are interposed (glibc only) and operator new/delete go through them, so
+// both C++ objects and Arduino Strings are seen. Scopes don't nest.
+class AllocScope {
+public:
+  AllocScope();
+  ~AllocScope();
+  AllocScope(const AllocScope &) = delete;
+  AllocScope &operator=(const AllocScope &) = delete;
+
+  AllocStats stats() const;
+
+  // False where malloc can't be interposed - budget tests skip themselves
+  static bool supported();
+};
+
+#endif // MAKER_API_ALLOC_TRACKER_H
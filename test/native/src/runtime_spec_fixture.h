@@ -0,0 +1,20 @@
+#ifndef MAKER_API_RUNTIME_SPEC_FIXTURE_H
+#define MAKER_API_RUNTIME_SPEC_FIXTURE_H
+
+// The platform's runtime maker spec for this module's default routes,
+// checked by test_baked_spec_matches_runtime: every operation
+// MakerSpecBuilder bakes must equal the runtime spec's operation for the
+// same path and method. Capture it from a device running the module at its
+// default base path with WEB_PLATFORM_MAKERAPI=1 and the default feature
+// flags,
+//   curl http://<device>/maker/openapi.json
+// and paste the response between the delimiters below.
+//
+// No device capture has been checked in yet: while
+// MAKER_API_RUNTIME_SPEC_CAPTURED is 0 the test is reported as ignored.
+// Set it to 1 with the capture.
+#define MAKER_API_RUNTIME_SPEC_CAPTURED 0
+
+static const char MAKER_API_RUNTIME_SPEC_FIXTURE[] = R"fixture({})fixture";
+
+#endif // MAKER_API_RUNTIME_SPEC_FIXTURE_H
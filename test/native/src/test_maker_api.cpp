@@ -1,16 +1,27 @@
 #include <unity.h>
 
-#ifdef NATIVE_PLATFORM
+// The headless build has its own suite (test/native_headless)
+#if defined(NATIVE_PLATFORM) && !MAKER_API_HEADLESS
 
 // Use ArduinoFake for proper Arduino mocking
 #include <ArduinoFake.h>
 #include <ArduinoJson.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
 // Use centralized testing infrastructure from web_platform_interface
 #include <testing/testing_platform_provider.h>
 
 // Include the actual maker_api header
 #include <maker_api.h>
+#include <maker_api_spec.h>
 
 // Define compilation flags for testing if not already defined
 #ifndef OPENAPI_ENABLED
@@ -31,9 +42,15 @@
 
 // Include assets for verification
 #include "../../../assets/maker_api_dashboard_html.h"
+#include "../../../assets/maker_api_spec_worker_js.h"
 #include "../../../assets/maker_api_styles_css.h"
+#include "../../../assets/maker_api_sw_js.h"
 #include "../../../assets/maker_api_utils_js.h"
 
+#include "alloc_budgets.h"
+#include "runtime_spec_fixture.h"
+#include "alloc_tracker.h"
+
 // maker_api's tests share one MakerAPIModule/MockWebPlatformProvider fixture
 // per test (built in setUp(), torn down in tearDown()) rather than
 // constructing local instances per test like sibling modules - kept as-is
@@ -89,8 +106,10 @@ static void test_maker_api_http_routes() {
   auto &module = *testModule;
   std::vector<RouteVariant> routes = module.getHttpRoutes();
 
-  // Should have exactly 4 routes: dashboard, CSS, JS, and config API
-  TEST_ASSERT_EQUAL(4, routes.size());
+  // Should have exactly 18 routes: dashboard, CSS, JS, spec worker, service
+  // worker, config/metrics/loop timing/heap/trace APIs, the metrics stream,
+  // batch, benchmark, Prometheus metrics and the four feature scripts
+  TEST_ASSERT_EQUAL(18, routes.size());
 
   // All routes should be properly initialized
   for (const auto &route : routes) {
@@ -106,7 +125,7 @@ static void test_maker_api_https_routes() {
   std::vector<RouteVariant> httpsRoutes = module.getHttpsRoutes();
 
   TEST_ASSERT_EQUAL(httpRoutes.size(), httpsRoutes.size());
-  TEST_ASSERT_EQUAL(4, httpsRoutes.size());
+  TEST_ASSERT_EQUAL(18, httpsRoutes.size());
 }
 
 // Test OpenAPI documentation generation
@@ -130,10 +149,10 @@ static void test_maker_api_openapi_docs() {
 static void test_maker_api_config_api_handler() {
   auto &module = *testModule;
   std::vector<RouteVariant> routes = module.getHttpRoutes();
-  TEST_ASSERT_GREATER_THAN(3, routes.size());
+  TEST_ASSERT_GREATER_THAN(5, routes.size());
 
-  // Get API config route (should be fourth route)
-  RouteVariant configRoute = routes[3];
+  // Get API config route (should be sixth route)
+  RouteVariant configRoute = routes[5];
   if (configRoute.isApiRoute()) {
     const ApiRoute &apiRoute = configRoute.getApiRoute();
     TEST_ASSERT_TRUE(apiRoute.webRoute.path.indexOf("config") > 0);
@@ -191,7 +210,7 @@ static void test_get_platform_helper() {
   std::vector<RouteVariant> routes = testModule->getHttpRoutes();
 
   // If we get routes back, getPlatform() was accessed successfully
-  TEST_ASSERT_EQUAL(4, routes.size());
+  TEST_ASSERT_EQUAL(18, routes.size());
 
   // Test that module methods complete successfully (indicating getPlatform()
   // works)
@@ -211,10 +230,10 @@ static void test_get_platform_helper() {
 // Test OpenAPI config handler verification (covers lines 52-73)
 static void test_openapi_config_handler_with_flags() {
   std::vector<RouteVariant> routes = testModule->getHttpRoutes();
-  TEST_ASSERT_EQUAL(4, routes.size());
+  TEST_ASSERT_EQUAL(18, routes.size());
 
-  // Get the config API route (4th route) and verify it's properly configured
-  RouteVariant configRoute = routes[3];
+  // Get the config API route (6th route) and verify it's properly configured
+  RouteVariant configRoute = routes[5];
   TEST_ASSERT_TRUE(configRoute.isApiRoute());
 
   const ApiRoute &apiRoute = configRoute.getApiRoute();
@@ -248,7 +267,7 @@ static void test_openapi_config_handler_with_flags() {
 // Test static asset route structure (covers lines 81, 83, 90-92, 98, 100-101)
 static void test_static_asset_routes() {
   std::vector<RouteVariant> routes = testModule->getHttpRoutes();
-  TEST_ASSERT_EQUAL(4, routes.size());
+  TEST_ASSERT_EQUAL(18, routes.size());
 
   // Test dashboard route structure (HTML)
   RouteVariant dashboardRoute = routes[0];
@@ -279,10 +298,1473 @@ static void test_static_asset_routes() {
   TEST_ASSERT_EQUAL(1,
                     jsWebRoute.authRequirements.size()); // Should be NONE auth
 
+  // Test spec worker route structure
+  RouteVariant workerRoute = routes[3];
+  TEST_ASSERT_TRUE(workerRoute.isWebRoute());
+
+  const WebRoute &workerWebRoute = workerRoute.getWebRoute();
+  TEST_ASSERT_TRUE(workerWebRoute.path.indexOf("maker-api-spec-worker.js") >
+                   0);
+  TEST_ASSERT_NOT_NULL(workerWebRoute.unifiedHandler);
+  TEST_ASSERT_EQUAL(
+      1, workerWebRoute.authRequirements.size()); // Should be NONE auth
+
+  // Test service worker route structure - must sit at the module root so its
+  // scope is the module prefix
+  RouteVariant swRoute = routes[4];
+  TEST_ASSERT_TRUE(swRoute.isWebRoute());
+
+  const WebRoute &swWebRoute = swRoute.getWebRoute();
+  TEST_ASSERT_EQUAL_STRING("/maker-api-sw.js", swWebRoute.path.c_str());
+  TEST_ASSERT_NOT_NULL(swWebRoute.unifiedHandler);
+  TEST_ASSERT_EQUAL(1,
+                    swWebRoute.authRequirements.size()); // Should be NONE auth
+
   // Verify static assets are available in memory
   TEST_ASSERT_NOT_NULL(MAKER_API_DASHBOARD_HTML);
   TEST_ASSERT_NOT_NULL(MAKER_API_STYLES_CSS);
   TEST_ASSERT_NOT_NULL(MAKER_API_UTILS_JS);
+  TEST_ASSERT_NOT_NULL(MAKER_API_SPEC_WORKER_JS);
+  TEST_ASSERT_NOT_NULL(MAKER_API_SW_JS);
+}
+
+// Test asset fingerprint used for ETags and the service worker cache version
+static void test_asset_version_fingerprint() {
+  const String &version = testModule->getAssetVersion();
+  TEST_ASSERT_EQUAL(8, version.length());
+
+  for (unsigned int i = 0; i < version.length(); i++) {
+    char c = version.charAt(i);
+    TEST_ASSERT_TRUE((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'));
+  }
+
+  // Same assets, same fingerprint - regardless of instance
+  MockWebPlatformProvider otherProvider;
+  MakerAPIModule other(&otherProvider);
+  TEST_ASSERT_EQUAL(0, other.getAssetVersion().length()); // Not begun yet
+  other.begin();
+  TEST_ASSERT_EQUAL_STRING(version.c_str(), other.getAssetVersion().c_str());
+}
+
+// Test the optional feature scripts: served after the other routes, public,
+// and listed in /api/config so the dashboard loads exactly these
+static void test_feature_asset_routes() {
+  const char *const paths[] = {
+      "/assets/maker-api-codegen.js", "/assets/maker-api-tokens.js",
+      "/assets/maker-api-load-test.js", "/assets/maker-api-batch.js"};
+
+  std::vector<RouteVariant> routes = testModule->getHttpRoutes();
+  TEST_ASSERT_EQUAL(18, routes.size());
+  for (size_t i = 0; i < 4; i++) {
+    const RouteVariant &route = routes[14 + i];
+    TEST_ASSERT_TRUE(route.isWebRoute());
+    TEST_ASSERT_EQUAL_STRING(paths[i], route.getWebRoute().path.c_str());
+    TEST_ASSERT_EQUAL(WebModule::WM_GET, route.getWebRoute().method);
+    TEST_ASSERT_EQUAL(1, route.getWebRoute().authRequirements.size());
+  }
+
+  // Handlers need a platform, which the default-constructed fixture lacks
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  routes = module.getHttpRoutes();
+
+  RequestT req;
+  ResponseT res;
+  routes[5].getApiRoute().webRoute.unifiedHandler(req, res);
+  JsonDocument config;
+  TEST_ASSERT_FALSE(deserializeJson(config, res.getContent().c_str()));
+  JsonObject features = config["features"].as<JsonObject>();
+  TEST_ASSERT_EQUAL(4, features.size());
+  TEST_ASSERT_EQUAL_STRING(paths[0], features["codegen"] | "");
+  TEST_ASSERT_EQUAL_STRING(paths[1], features["tokens"] | "");
+  TEST_ASSERT_EQUAL_STRING(paths[2], features["load-test"] | "");
+  TEST_ASSERT_EQUAL_STRING(paths[3], features["batch"] | "");
+}
+
+// Check a baked operation carries its route's docs: operationId, one
+// security alternative per auth type, request body and response
+// schema/example
+static void assertOperationDocs(const ApiRoute &route,
+                                JsonObjectConst operation) {
+  const OpenAPIDocumentation &docs = route.docs;
+  TEST_ASSERT_EQUAL_STRING(String(docs.operationId).c_str(),
+                           operation["operationId"] | "");
+  TEST_ASSERT_EQUAL_STRING(docs.getSummary().c_str(),
+                           operation["summary"] | "");
+
+  JsonArrayConst security = operation["security"];
+  TEST_ASSERT_EQUAL(route.webRoute.authRequirements.size(), security.size());
+
+  JsonDocument fragment;
+  if (String(docs.requestExample).length() > 0) {
+    TEST_ASSERT_FALSE(deserializeJson(fragment, String(docs.requestExample)));
+    TEST_ASSERT_TRUE(
+        operation["requestBody"]["content"]["application/json"]["example"] ==
+        fragment.as<JsonVariantConst>());
+  } else {
+    TEST_ASSERT_TRUE(operation["requestBody"].isNull());
+  }
+
+  JsonObjectConst success =
+      operation["responses"]["200"]["content"]["application/json"];
+  if (String(docs.responseSchema).length() > 0) {
+    TEST_ASSERT_FALSE(deserializeJson(fragment, String(docs.responseSchema)));
+    TEST_ASSERT_TRUE(success["schema"] == fragment.as<JsonVariantConst>());
+  }
+  if (String(docs.responseExample).length() > 0) {
+    TEST_ASSERT_FALSE(deserializeJson(fragment, String(docs.responseExample)));
+    TEST_ASSERT_TRUE(success["example"] == fragment.as<JsonVariantConst>());
+  }
+}
+
+// Test a baked spec documents the module's routes from their docs, is
+// embedded verbatim in its header, and is served as-is
+static void test_baked_spec() {
+  MakerAPIModule module(mockProvider.get());
+  const String basePath = module.getBasePath();
+
+  // Tags as the bake_native env uses by default
+  MakerSpecBuilder baker({"maker", "Maker API"});
+  baker.addRoutes(basePath, module.getHttpRoutes());
+  const String baked =
+      baker.serialize(module.getModuleName(), module.getModuleVersion());
+
+  JsonDocument spec;
+  TEST_ASSERT_FALSE(deserializeJson(spec, baked.c_str()));
+  TEST_ASSERT_EQUAL_STRING("3.0.3", spec["openapi"] | "");
+  TEST_ASSERT_EQUAL(6 + MAKER_API_FEATURE_BATCH + MAKER_API_FEATURE_LOAD_TEST,
+                    baker.getOperationCount());
+
+  size_t checked = 0;
+  for (const RouteVariant &route : module.getHttpRoutes()) {
+    if (!route.isApiRoute()) {
+      continue;
+    }
+    const ApiRoute &apiRoute = route.getApiRoute();
+    // The module only registers GET and POST routes
+    const char *method =
+        apiRoute.webRoute.method == WebModule::WM_POST ? "post" : "get";
+    JsonObjectConst operation =
+        spec["paths"][basePath + "/api" + apiRoute.webRoute.path][method];
+    if (operation.isNull()) {
+      continue; // Not a maker route
+    }
+    assertOperationDocs(apiRoute, operation);
+    checked++;
+  }
+  TEST_ASSERT_EQUAL(baker.getOperationCount(), checked);
+
+  // Schemes are only named until definitions are adopted
+  TEST_ASSERT_TRUE(spec["components"].isNull());
+
+  // The whole operation, for a route whose docs are known here
+  std::vector<RouteVariant> sumRoutes;
+  sumRoutes.push_back(ApiRoute(
+      "/sum", WebModule::WM_POST, [](RequestT &, ResponseT &) {},
+      {AuthType::NONE, AuthType::TOKEN},
+      OpenAPIFactory::create("Add numbers", "Adds a and b", "addNumbers",
+                             {"maker"})
+          .withRequestExample(R"({"a": 1, "b": 2})")
+          .withResponseExample(R"({"sum": 3})")));
+  MakerSpecBuilder sumBaker;
+  TEST_ASSERT_FALSE(sumBaker.adoptSecuritySchemes(R"({"paths":{}})"));
+  TEST_ASSERT_TRUE(sumBaker.adoptSecuritySchemes(
+      R"({"components":{"securitySchemes":{)"
+      R"("bearerAuth":{"type":"http","scheme":"bearer"},)"
+      R"("cookieAuth":{"type":"apiKey","in":"cookie","name":"sid"}}}})"));
+  sumBaker.addRoutes("/calc", sumRoutes);
+  JsonDocument sumSpec;
+  TEST_ASSERT_FALSE(deserializeJson(
+      sumSpec, sumBaker.serialize("Calc", "1.0").c_str()));
+  String sumOperation;
+  serializeJson(sumSpec["paths"]["/calc/api/sum"]["post"], sumOperation);
+  TEST_ASSERT_EQUAL_STRING(
+      R"({"operationId":"addNumbers","summary":"Add numbers",)"
+      R"("description":"Adds a and b","tags":["maker"],)"
+      R"("security":[{},{"bearerAuth":[]}],)"
+      R"("requestBody":{"required":true,"content":{"application/json":)"
+      R"({"example":{"a":1,"b":2}}}},"responses":{"200":{"description":)"
+      R"("Success","content":{"application/json":{"example":{"sum":3}}}}}})",
+      sumOperation.c_str());
+  // Only the adopted definitions the operations use
+  String sumSchemes;
+  serializeJson(sumSpec["components"]["securitySchemes"], sumSchemes);
+  TEST_ASSERT_EQUAL_STRING(
+      R"({"bearerAuth":{"type":"http","scheme":"bearer"}})",
+      sumSchemes.c_str());
+
+  // The header embeds the JSON verbatim
+  const String header =
+      MakerSpecBuilder::toHeader(baked, "MAKER_API_BAKED_SPEC_JSON");
+  const char *open = "R\"makerapi(";
+  const int start = header.indexOf(open) + strlen(open);
+  const int end = header.indexOf(")makerapi\"");
+  TEST_ASSERT_TRUE(start > 0 && end > start);
+  TEST_ASSERT_EQUAL_STRING(baked.c_str(),
+                           header.substring(start, end).c_str());
+
+  // Untagged routes stay out
+  MakerSpecBuilder makerOnly;
+  makerOnly.addRoutes(basePath, module.getHttpRoutes());
+  TEST_ASSERT_EQUAL(0, makerOnly.getOperationCount());
+
+  module.setBakedSpec(baked.c_str());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  TEST_ASSERT_EQUAL(19, routes.size());
+
+  // Baking again with the spec route registered changes nothing
+  MakerSpecBuilder again({"maker", "Maker API"});
+  again.addRoutes(basePath, routes);
+  TEST_ASSERT_EQUAL_STRING(
+      baked.c_str(),
+      again.serialize(module.getModuleName(), module.getModuleVersion())
+          .c_str());
+
+  const WebRoute &specRoute = routes.back().getWebRoute();
+  TEST_ASSERT_EQUAL_STRING("/openapi.json", specRoute.path.c_str());
+  TEST_ASSERT_EQUAL(WebModule::WM_GET, specRoute.method);
+
+  RequestT req;
+  ResponseT res;
+  specRoute.unifiedHandler(req, res);
+  TEST_ASSERT_EQUAL_STRING(baked.c_str(), res.getContent().c_str());
+
+  // /api/config points the dashboard at it
+  ResponseT configRes;
+  routes[5].getApiRoute().webRoute.unifiedHandler(req, configRes);
+  JsonDocument configJson;
+  TEST_ASSERT_FALSE(deserializeJson(configJson, configRes.getContent().c_str()));
+  TEST_ASSERT_TRUE(configJson["OpenApiConfig"]["makerSpec"] | false);
+  TEST_ASSERT_EQUAL_STRING("/openapi.json",
+                           configJson["OpenApiConfig"]["makerSpecUrl"] | "");
+}
+
+// Test a PAGE_TOKEN-only route reaches the dashboard: the spec route serves
+// the baked document unchanged whatever credentials the request carries,
+// with one ETag that revalidates to a 304
+static void test_baked_spec_page_token() {
+  MakerAPIModule module(mockProvider.get());
+  std::vector<RouteVariant> pageRoutes;
+  pageRoutes.push_back(ApiRoute(
+      "/page-action", WebModule::WM_POST, [](RequestT &, ResponseT &) {},
+      {AuthType::PAGE_TOKEN},
+      OpenAPIFactory::create("Page action", "Only callable from a page",
+                             "pageAction", {"maker"})));
+  MakerSpecBuilder baker;
+  baker.addRoutes("/app", pageRoutes);
+  const String baked = baker.serialize("App", "1.0");
+
+  module.setBakedSpec(baked.c_str());
+  module.begin();
+  const WebRoute &specRoute = module.getHttpRoutes().back().getWebRoute();
+
+  RequestT pageReq;
+  pageReq.setHeader("Cookie", "session=abc");
+  ResponseT pageRes;
+  specRoute.unifiedHandler(pageReq, pageRes);
+  TEST_ASSERT_EQUAL_STRING(baked.c_str(), pageRes.getContent().c_str());
+
+  JsonDocument spec;
+  TEST_ASSERT_FALSE(deserializeJson(spec, pageRes.getContent().c_str()));
+  JsonObjectConst operation = spec["paths"]["/app/api/page-action"]["post"];
+  TEST_ASSERT_FALSE(operation.isNull());
+  TEST_ASSERT_EQUAL(1, operation["security"].size());
+  TEST_ASSERT_TRUE(
+      operation["security"][0]["pageTokenAuth"].is<JsonArrayConst>());
+
+  // A bearer client gets the same document and ETag
+  RequestT tokenReq;
+  tokenReq.setHeader("Authorization", "Bearer xyz");
+  ResponseT tokenRes;
+  specRoute.unifiedHandler(tokenReq, tokenRes);
+  TEST_ASSERT_EQUAL_STRING(baked.c_str(), tokenRes.getContent().c_str());
+  const String etag = pageRes.getHeader("ETag");
+  TEST_ASSERT_EQUAL(10, etag.length());
+  TEST_ASSERT_EQUAL_STRING(etag.c_str(), tokenRes.getHeader("ETag").c_str());
+
+  RequestT revalidate;
+  revalidate.setHeader("If-None-Match", etag);
+  ResponseT notModified;
+  specRoute.unifiedHandler(revalidate, notModified);
+  TEST_ASSERT_EQUAL(304, notModified.getStatus());
+  TEST_ASSERT_EQUAL(0, notModified.getContent().length());
+}
+
+// Test the baked operations equal the platform's runtime spec for the same
+// routes, captured from a device in runtime_spec_fixture.h
+static void test_baked_spec_matches_runtime() {
+  if (!MAKER_API_RUNTIME_SPEC_CAPTURED) {
+    TEST_IGNORE_MESSAGE("No runtime spec captured yet - see "
+                        "test/native/src/runtime_spec_fixture.h");
+  }
+  JsonDocument runtime;
+  TEST_ASSERT_FALSE(deserializeJson(runtime, MAKER_API_RUNTIME_SPEC_FIXTURE));
+
+  MakerAPIModule module(mockProvider.get());
+  MakerSpecBuilder baker({"maker", "Maker API"});
+  TEST_ASSERT_TRUE(
+      baker.adoptSecuritySchemes(MAKER_API_RUNTIME_SPEC_FIXTURE));
+  baker.addRoutes(module.getBasePath(), module.getHttpRoutes());
+  JsonDocument baked;
+  TEST_ASSERT_FALSE(deserializeJson(
+      baked,
+      baker.serialize(module.getModuleName(), module.getModuleVersion())
+          .c_str()));
+
+  size_t compared = 0;
+  for (JsonPairConst path : baked["paths"].as<JsonObjectConst>()) {
+    for (JsonPairConst operation : path.value().as<JsonObjectConst>()) {
+      JsonVariantConst expected =
+          runtime["paths"][path.key()][operation.key()];
+      String bakedJson;
+      String runtimeJson;
+      serializeJson(operation.value(), bakedJson);
+      serializeJson(expected, runtimeJson);
+      const String message = String(operation.key().c_str()) + " " +
+                             path.key().c_str() + "\nbaked:   " + bakedJson +
+                             "\nruntime: " + runtimeJson;
+      TEST_ASSERT_TRUE_MESSAGE(operation.value() == expected,
+                               message.c_str());
+      compared++;
+    }
+  }
+  TEST_ASSERT_EQUAL(baker.getOperationCount(), compared);
+}
+
+// Test the module's API routes are recorded in its metrics table, once each
+// however many times routes are built (HTTP and HTTPS)
+static void test_api_routes_instrumented() {
+  std::vector<RouteVariant> routes = testModule->getHttpRoutes();
+  testModule->getHttpsRoutes();
+
+  const RouteMetrics &metrics = testModule->getMetrics();
+  TEST_ASSERT_EQUAL(5, metrics.size());
+  TEST_ASSERT_EQUAL(0, metrics.getDroppedRegistrations());
+
+  RouteMetrics::Snapshot snapshot;
+  TEST_ASSERT_TRUE(metrics.snapshot(0, snapshot));
+  TEST_ASSERT_EQUAL_STRING("Maker API", snapshot.module);
+  TEST_ASSERT_EQUAL_STRING("/config", snapshot.path);
+  TEST_ASSERT_EQUAL_STRING("POST", snapshot.method);
+  TEST_ASSERT_EQUAL(0, snapshot.count);
+
+  TEST_ASSERT_TRUE(metrics.snapshot(1, snapshot));
+  TEST_ASSERT_EQUAL_STRING("/metrics", snapshot.path);
+  TEST_ASSERT_EQUAL_STRING("GET", snapshot.method);
+
+  TEST_ASSERT_TRUE(metrics.snapshot(2, snapshot));
+  TEST_ASSERT_EQUAL_STRING("/loop", snapshot.path);
+
+  TEST_ASSERT_TRUE(metrics.snapshot(3, snapshot));
+  TEST_ASSERT_EQUAL_STRING("/heap", snapshot.path);
+
+  TEST_ASSERT_TRUE(metrics.snapshot(4, snapshot));
+  TEST_ASSERT_EQUAL_STRING("/trace", snapshot.path);
+
+  // Metrics route sits after the config route
+  RouteVariant metricsRoute = routes[6];
+  TEST_ASSERT_TRUE(metricsRoute.isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/metrics",
+                           metricsRoute.getApiRoute().webRoute.path.c_str());
+  TEST_ASSERT_TRUE(
+      metricsRoute.getApiRoute().webRoute.authRequirements.size() > 0);
+
+  // The metrics stream follows the instrumented API routes, uninstrumented
+  RouteVariant streamRoute = routes[10];
+  TEST_ASSERT_TRUE(streamRoute.isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/metrics/stream",
+                           streamRoute.getApiRoute().webRoute.path.c_str());
+
+  // Batch dispatches to instrumented routes, so it mustn't be one itself
+  RouteVariant batchRoute = routes[11];
+  TEST_ASSERT_TRUE(batchRoute.isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/batch",
+                           batchRoute.getApiRoute().webRoute.path.c_str());
+  TEST_ASSERT_EQUAL(WebModule::WM_POST,
+                    batchRoute.getApiRoute().webRoute.method);
+  TEST_ASSERT_EQUAL(3,
+                    batchRoute.getApiRoute().webRoute.authRequirements.size());
+
+  RouteVariant benchmarkRoute = routes[12];
+  TEST_ASSERT_TRUE(benchmarkRoute.isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/benchmark",
+                           benchmarkRoute.getApiRoute().webRoute.path.c_str());
+
+  // Prometheus scrape route is a plain (non-/api) route and not itself
+  // instrumented
+  RouteVariant prometheusRoute = routes[13];
+  TEST_ASSERT_TRUE(prometheusRoute.isWebRoute());
+  TEST_ASSERT_EQUAL_STRING("/metrics",
+                           prometheusRoute.getWebRoute().path.c_str());
+  TEST_ASSERT_EQUAL(2, prometheusRoute.getWebRoute().authRequirements.size());
+}
+
+// Test metrics recording: count, 64-bit total across 32-bit wrap, min/max,
+// heap deltas, reset and the full-table path
+static void test_route_metrics_recording() {
+  RouteMetrics metrics;
+  int slot = metrics.registerRoute("Test", "/a", "GET");
+  TEST_ASSERT_EQUAL(0, slot);
+
+  metrics.record(slot, 100, 64);
+  metrics.record(slot, UINT32_MAX - 10, -32);
+  metrics.record(slot, 50, 0);
+
+  RouteMetrics::Snapshot snapshot;
+  TEST_ASSERT_TRUE(metrics.snapshot(slot, snapshot));
+  TEST_ASSERT_EQUAL(3, snapshot.count);
+  TEST_ASSERT_TRUE(snapshot.totalMicros ==
+                   100ULL + (UINT32_MAX - 10ULL) + 50ULL);
+  TEST_ASSERT_EQUAL(50, snapshot.minMicros);
+  TEST_ASSERT_EQUAL(UINT32_MAX - 10, snapshot.maxMicros);
+  TEST_ASSERT_EQUAL(32, snapshot.heapDeltaTotal);
+  TEST_ASSERT_EQUAL(64, snapshot.heapDeltaMax);
+  TEST_ASSERT_EQUAL(3, snapshot.histogram->totalCount());
+
+  // Each record bumps the generation the stream diffs against
+  TEST_ASSERT_EQUAL(3, metrics.getGeneration());
+  TEST_ASSERT_EQUAL(3, snapshot.changedAt);
+  const int quiet = metrics.registerRoute("Test", "/quiet", "GET");
+  TEST_ASSERT_TRUE(metrics.snapshot(quiet, snapshot));
+  TEST_ASSERT_EQUAL(0, snapshot.changedAt);
+
+  metrics.reset();
+  TEST_ASSERT_EQUAL(4, metrics.getGeneration());
+  TEST_ASSERT_TRUE(metrics.snapshot(quiet, snapshot));
+  TEST_ASSERT_EQUAL(4, snapshot.changedAt); // Reset changes every route
+  TEST_ASSERT_TRUE(metrics.snapshot(slot, snapshot));
+  TEST_ASSERT_EQUAL(0, snapshot.count);
+  TEST_ASSERT_EQUAL(0, snapshot.minMicros);
+  TEST_ASSERT_EQUAL_STRING("/a", snapshot.path); // Registration survives
+
+  // The heap delta stays on when its free-heap reads fit the budget, and
+  // can be turned off by hand
+  TEST_ASSERT_TRUE(metrics.isHeapDeltaEnabled());
+  const uint32_t sampleNanos = metrics.calibrateHeapDelta(UINT32_MAX);
+  TEST_ASSERT_EQUAL(sampleNanos, metrics.getHeapSampleNanos());
+  TEST_ASSERT_TRUE(metrics.isHeapDeltaEnabled());
+  metrics.setHeapDeltaEnabled(false);
+  TEST_ASSERT_FALSE(metrics.isHeapDeltaEnabled());
+
+  // Fill the table; further routes are refused and counted
+  for (size_t i = 2; i < RouteMetrics::kMaxRoutes; i++) {
+    String path = "/r" + String(static_cast<unsigned int>(i));
+    TEST_ASSERT_EQUAL(i, metrics.registerRoute("Test", path.c_str(), "GET"));
+  }
+  TEST_ASSERT_EQUAL(-1, metrics.registerRoute("Test", "/overflow", "GET"));
+  TEST_ASSERT_EQUAL(1, metrics.getDroppedRegistrations());
+  TEST_ASSERT_EQUAL(RouteMetrics::kMaxRoutes, metrics.size());
+
+  // Recording against a refused slot is a no-op
+  metrics.record(-1, 10, 0);
+}
+
+// Test the histogram bucket layout is contiguous and round-trips
+static void test_latency_histogram_buckets() {
+  for (size_t i = 0; i < LatencyHistogram::kBuckets; i++) {
+    const uint32_t lower = LatencyHistogram::bucketLowerBound(i);
+    const uint32_t width = LatencyHistogram::bucketWidth(i);
+    TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketFor(lower));
+    TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketFor(lower + width - 1));
+    if (i + 1 < LatencyHistogram::kBuckets) {
+      TEST_ASSERT_EQUAL(lower + width,
+                        LatencyHistogram::bucketLowerBound(i + 1));
+    }
+  }
+
+  // Small values are exact; the last finite bucket ends at 2^25us and
+  // anything longer is counted apart from it
+  TEST_ASSERT_EQUAL(0, LatencyHistogram::bucketFor(0));
+  TEST_ASSERT_EQUAL(7, LatencyHistogram::bucketFor(7));
+  const uint32_t lastBound = 1u << LatencyHistogram::kMaxExponent;
+  TEST_ASSERT_EQUAL(lastBound,
+                    LatencyHistogram::bucketLowerBound(
+                        LatencyHistogram::kBuckets - 1) +
+                        LatencyHistogram::bucketWidth(
+                            LatencyHistogram::kBuckets - 1));
+  TEST_ASSERT_EQUAL(LatencyHistogram::kBuckets - 1,
+                    LatencyHistogram::bucketFor(lastBound - 1));
+  TEST_ASSERT_EQUAL(LatencyHistogram::kOverflowBucket,
+                    LatencyHistogram::bucketFor(lastBound));
+  TEST_ASSERT_EQUAL(LatencyHistogram::kOverflowBucket,
+                    LatencyHistogram::bucketFor(UINT32_MAX));
+
+  // Overflows are counted, and a percentile landing on them is unbounded
+  // rather than reported as ~30s
+  LatencyHistogram histogram;
+  histogram.record(30000000);
+  histogram.record(UINT32_MAX);
+  TEST_ASSERT_EQUAL(1, histogram.count(LatencyHistogram::kBuckets - 1));
+  TEST_ASSERT_EQUAL(1, histogram.count(LatencyHistogram::kOverflowBucket));
+  TEST_ASSERT_EQUAL(2, histogram.totalCount());
+  TEST_ASSERT_TRUE(histogram.percentile(50) < lastBound);
+  TEST_ASSERT_EQUAL(UINT32_MAX, histogram.percentile(100));
+}
+
+// Test histogram percentiles against a reference sort of the same samples
+static void test_latency_histogram_percentiles() {
+  LatencyHistogram histogram;
+  TEST_ASSERT_EQUAL(0, histogram.percentile(50));
+
+  // Log-uniform samples from 1us to ~1s (deterministic LCG)
+  std::vector<uint32_t> samples;
+  uint32_t seed = 12345;
+  for (int i = 0; i < 5000; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    const double exponent = (seed >> 8) / static_cast<double>(1 << 24) * 20.0;
+    const uint32_t micros = static_cast<uint32_t>(std::pow(2.0, exponent));
+    samples.push_back(micros);
+    histogram.record(micros);
+  }
+  std::sort(samples.begin(), samples.end());
+  TEST_ASSERT_EQUAL(samples.size(), histogram.totalCount());
+
+  const double percents[] = {1, 10, 50, 90, 99, 99.9, 100};
+  for (double percent : percents) {
+    const size_t rank = static_cast<size_t>(
+        std::ceil(percent / 100.0 * static_cast<double>(samples.size())));
+    const double expected = samples[rank - 1];
+    const double actual = histogram.percentile(percent);
+
+    // Bucket midpoints are within half a bucket (12.5%) of any member
+    TEST_ASSERT_TRUE(std::fabs(actual - expected) <= expected * 0.125 + 1);
+  }
+
+  histogram.reset();
+  TEST_ASSERT_EQUAL(0, histogram.totalCount());
+}
+
+// Test loop timing statistics and the ring buffer window
+static void test_loop_timing() {
+  LoopTiming timing;
+  LoopTiming::Summary summary = timing.summarize();
+  TEST_ASSERT_EQUAL(0, summary.iterations);
+  TEST_ASSERT_EQUAL(0, summary.samples);
+
+  // First tick only starts the clock
+  timing.tick(1000);
+  timing.tick(2000);
+  timing.tick(3500);
+  timing.tick(4000);
+
+  summary = timing.summarize();
+  TEST_ASSERT_EQUAL(4, summary.iterations);
+  TEST_ASSERT_EQUAL(3, summary.samples);
+  TEST_ASSERT_EQUAL(1000, summary.periodMicros);
+  TEST_ASSERT_EQUAL(408, summary.jitterMicros); // stddev of 1000/1500/500
+  TEST_ASSERT_EQUAL(500, summary.minMicros);
+  TEST_ASSERT_EQUAL(1500, summary.maxMicros);
+  TEST_ASSERT_EQUAL(1500, summary.longestMicros);
+
+  // Wrapping clock still yields the right gap
+  LoopTiming wrapping;
+  wrapping.tick(UINT32_MAX - 99);
+  wrapping.tick(100);
+  TEST_ASSERT_EQUAL(200, wrapping.summarize().maxMicros);
+
+  // Past the ring size only the newest gaps are kept, oldest first; the
+  // longest gap since boot survives leaving the window
+  LoopTiming ring;
+  ring.tick(0);
+  ring.tick(50000);
+  uint32_t now = 50000;
+  for (size_t i = 0; i < LoopTiming::kSamples + 10; i++) {
+    now += 100 + static_cast<uint32_t>(i);
+    ring.tick(now);
+  }
+  uint32_t samples[LoopTiming::kSamples];
+  TEST_ASSERT_EQUAL(LoopTiming::kSamples,
+                    ring.copySamples(samples, LoopTiming::kSamples));
+  TEST_ASSERT_EQUAL(100 + 10, samples[0]);
+  TEST_ASSERT_EQUAL(100 + LoopTiming::kSamples + 9,
+                    samples[LoopTiming::kSamples - 1]);
+  summary = ring.summarize();
+  TEST_ASSERT_EQUAL(50000, summary.longestMicros);
+  TEST_ASSERT_TRUE(summary.maxMicros < 50000);
+
+  // The module ticks from handle()
+  testModule->handle();
+  testModule->handle();
+  testModule->handle();
+  TEST_ASSERT_EQUAL(3, testModule->getLoopTiming().summarize().iterations);
+}
+
+// Prometheus output collected for the format checker
+class StdStringSink : public MetricsSink {
+public:
+  void write(const char *data, size_t length) override {
+    text.append(data, length);
+  }
+  std::string text;
+};
+
+static bool isMetricNameChar(char c, bool first) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+         c == ':' || (!first && c >= '0' && c <= '9');
+}
+
+static size_t parseMetricName(const std::string &line, size_t pos) {
+  size_t end = pos;
+  while (end < line.size() && isMetricNameChar(line[end], end == pos)) {
+    end++;
+  }
+  return end;
+}
+
+// Strict checker for the Prometheus text format (0.0.4) as written by
+// PrometheusWriter: HELP/TYPE before each family's samples, families
+// contiguous and declared once, valid names, escaped label values, numeric
+// values, no timestamps, and consistent cumulative histograms. Returns an
+// empty string when valid, otherwise what's wrong.
+static std::string checkPrometheusFormat(const std::string &text) {
+  if (text.empty() || text.back() != '\n') {
+    return "output must end with a newline";
+  }
+
+  std::map<std::string, std::string> types;
+  std::string family;
+  std::map<std::string, double> lastBucket; // label set -> cumulative count
+  std::map<std::string, double> infBucket;
+
+  size_t start = 0;
+  while (start < text.size()) {
+    const size_t newline = text.find('\n', start);
+    const std::string line = text.substr(start, newline - start);
+    start = newline + 1;
+
+    if (line.rfind("# HELP ", 0) == 0) {
+      const size_t end = parseMetricName(line, 7);
+      if (end == 7 || end >= line.size() || line[end] != ' ') {
+        return "bad HELP line: " + line;
+      }
+      continue;
+    }
+    if (line.rfind("# TYPE ", 0) == 0) {
+      const size_t end = parseMetricName(line, 7);
+      const std::string name = line.substr(7, end - 7);
+      const std::string type = end < line.size() ? line.substr(end + 1) : "";
+      if (name.empty() || line[end] != ' ' ||
+          (type != "counter" && type != "gauge" && type != "histogram")) {
+        return "bad TYPE line: " + line;
+      }
+      if (types.count(name)) {
+        return "family declared twice: " + name;
+      }
+      types[name] = type;
+      family = name;
+      continue;
+    }
+    if (line.empty() || line[0] == '#') {
+      return "unexpected line: '" + line + "'";
+    }
+
+    // Sample: name{labels} value
+    const size_t nameEnd = parseMetricName(line, 0);
+    const std::string name = line.substr(0, nameEnd);
+    if (name.empty()) {
+      return "bad metric name: " + line;
+    }
+    std::string suffix;
+    if (name != family) {
+      const bool histogram = types[family] == "histogram";
+      for (const char *candidate : {"_bucket", "_sum", "_count"}) {
+        if (histogram && name == family + candidate) {
+          suffix = candidate;
+        }
+      }
+      if (suffix.empty()) {
+        return "sample outside its family: " + line;
+      }
+    }
+
+    size_t pos = nameEnd;
+    std::string labelSet;
+    std::string le;
+    if (pos < line.size() && line[pos] == '{') {
+      pos++;
+      while (true) {
+        const size_t labelEnd = parseMetricName(line, pos);
+        if (labelEnd == pos || labelEnd + 1 >= line.size() ||
+            line.compare(labelEnd, 2, "=\"") != 0) {
+          return "bad label: " + line;
+        }
+        const std::string label = line.substr(pos, labelEnd - pos);
+        std::string value;
+        pos = labelEnd + 2;
+        while (pos < line.size() && line[pos] != '"') {
+          if (line[pos] == '\\') {
+            if (pos + 1 >= line.size() ||
+                (line[pos + 1] != '\\' && line[pos + 1] != '"' &&
+                 line[pos + 1] != 'n')) {
+              return "bad escape: " + line;
+            }
+            value += line[pos + 1];
+            pos += 2;
+          } else if (line[pos] == '\n') {
+            return "raw newline in label: " + line;
+          } else {
+            value += line[pos++];
+          }
+        }
+        if (pos >= line.size()) {
+          return "unterminated label value: " + line;
+        }
+        pos++; // Closing quote
+        if (label == "le") {
+          le = value;
+        } else {
+          labelSet += label + "=" + value + ";";
+        }
+        if (pos < line.size() && line[pos] == ',') {
+          pos++;
+          continue;
+        }
+        if (pos < line.size() && line[pos] == '}') {
+          pos++;
+          break;
+        }
+        return "bad label separator: " + line;
+      }
+    }
+
+    if (pos >= line.size() || line[pos] != ' ') {
+      return "missing value separator: " + line;
+    }
+    const std::string valueText = line.substr(pos + 1);
+    char *end = nullptr;
+    const double value = std::strtod(valueText.c_str(), &end);
+    if (valueText.empty() || *end != '\0') {
+      return "bad value (or trailing timestamp): " + line;
+    }
+
+    if (suffix == "_bucket") {
+      if (le.empty()) {
+        return "bucket without le: " + line;
+      }
+      if (lastBucket.count(labelSet) && value < lastBucket[labelSet]) {
+        return "bucket counts not cumulative: " + line;
+      }
+      lastBucket[labelSet] = value;
+      if (le == "+Inf") {
+        infBucket[labelSet] = value;
+      }
+    } else if (!le.empty()) {
+      return "le outside a bucket: " + line;
+    } else if (suffix == "_count") {
+      if (!infBucket.count(labelSet) || infBucket[labelSet] != value) {
+        return "_count doesn't match the +Inf bucket: " + line;
+      }
+      lastBucket.erase(labelSet);
+    }
+  }
+
+  return "";
+}
+
+// The JSON of a metrics stream event's data: line
+static bool parseStreamEvent(const String &event, JsonDocument &doc) {
+  const int data = event.indexOf("data: ");
+  if (data < 0) {
+    return false;
+  }
+  const String json = event.substring(data + 6, event.indexOf('\n', data));
+  return !deserializeJson(doc, json.c_str());
+}
+
+// Test the metrics stream's Last-Event-ID deltas: a fresh client gets every
+// route, a resumed one only the routes that changed since its ID, a new heap
+// sample only the heap, and an unchanged state just the new ID
+static void test_metrics_stream_events() {
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  module.setMetricsStreamInterval(500);
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  const uint32_t leases = module.getJsonArenaStats().leases;
+
+  String event = module.getMetricsStreamEvent("");
+  TEST_ASSERT_TRUE(event.startsWith("retry: 500\nid: 0-0\ndata: "));
+  JsonDocument doc;
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  TEST_ASSERT_EQUAL(5, doc["routes"].size());
+  TEST_ASSERT_TRUE(doc["loop"].is<JsonObject>());
+  TEST_ASSERT_FALSE(doc["heap"].is<JsonObject>());
+  TEST_ASSERT_EQUAL(leases + 1, module.getJsonArenaStats().leases);
+
+  // One request to /api/metrics: only that route is sent on resume
+  RequestT req;
+  ResponseT res;
+  routes[6].getApiRoute().webRoute.unifiedHandler(req, res);
+  event = module.getMetricsStreamEvent("0-0");
+  TEST_ASSERT_TRUE(event.startsWith("retry: 500\nid: 1-0\n"));
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  TEST_ASSERT_EQUAL(1, doc["routes"].size());
+  TEST_ASSERT_EQUAL_STRING("/metrics", doc["routes"][0]["path"] | "");
+  TEST_ASSERT_EQUAL(1, doc["routes"][0]["count"] | 0);
+
+  // Nothing changed since 1-0
+  event = module.getMetricsStreamEvent("1-0");
+  TEST_ASSERT_EQUAL_STRING("retry: 500\nid: 1-0\n\n", event.c_str());
+
+  // A heap sample alone: no routes, the current heap and the sample
+  module.handle();
+  event = module.getMetricsStreamEvent("1-0");
+  TEST_ASSERT_TRUE(event.startsWith("retry: 500\nid: 1-1\n"));
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  TEST_ASSERT_EQUAL(0, doc["routes"].size());
+  TEST_ASSERT_TRUE(doc["heap"]["current"].is<JsonObject>());
+  TEST_ASSERT_TRUE(doc["heap"]["sample"].is<JsonArray>());
+
+  // An ID from the future (the device rebooted) or garbage starts afresh
+  event = module.getMetricsStreamEvent("9-9");
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  TEST_ASSERT_EQUAL(5, doc["routes"].size());
+  event = module.getMetricsStreamEvent("not-an-id");
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  TEST_ASSERT_EQUAL(5, doc["routes"].size());
+
+  // A request past the last bucket is listed last, without an upper bound,
+  // and doesn't pull the percentiles up to ~30s
+  module.getMetrics().record(0, 40000000, 0);
+  event = module.getMetricsStreamEvent("");
+  TEST_ASSERT_TRUE(parseStreamEvent(event, doc));
+  JsonObject config = doc["routes"][0];
+  TEST_ASSERT_EQUAL_STRING("/config", config["path"] | "");
+  JsonArray overflow = config["histogram"][config["histogram"].size() - 1];
+  TEST_ASSERT_EQUAL(1u << LatencyHistogram::kMaxExponent, overflow[0] | 0u);
+  TEST_ASSERT_TRUE(overflow[1].isNull());
+  TEST_ASSERT_EQUAL(1, overflow[2] | 0);
+  TEST_ASSERT_EQUAL(40000000, config["p99Us"] | 0u);
+}
+
+// Test the Prometheus exposition passes a strict format check and carries
+// the recorded values
+static void test_prometheus_metrics_format() {
+  RouteMetrics &metrics = testModule->getMetrics();
+  testModule->getHttpRoutes(); // Registers the module's API routes
+
+  // A label value needing every escape
+  const int odd = metrics.registerRoute("Quote\"d", "/a\\b\nc", "GET");
+  metrics.record(odd, 3, 0);
+  metrics.record(odd, 1500, 64);
+  metrics.record(odd, 30000000, 0);   // In the last finite bucket
+  metrics.record(odd, 40000000, -16); // Beyond the last bound
+
+  metrics.record(0, 250, 0); // /config
+
+  StdStringSink sink;
+  testModule->writePrometheusMetrics(sink);
+
+  const std::string error = checkPrometheusFormat(sink.text);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("", error.c_str(), sink.text.c_str());
+
+  TEST_ASSERT_TRUE(sink.text.find(
+                       "makerapi_http_requests_total{module=\"Maker API\","
+                       "path=\"/config\",method=\"POST\"} 1\n") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("module=\"Quote\\\"d\",path=\"/a\\\\b\\nc\"") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("le=\"0.000008\"} 1\n") != std::string::npos);
+  // The last finite bound counts the sample just below it; only the
+  // overflow is left for +Inf
+  TEST_ASSERT_TRUE(sink.text.find("le=\"16.777216\"} 2\n") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("le=\"33.554432\"} 3\n") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("le=\"+Inf\"} 4\n") != std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("# TYPE makerapi_heap_free_bytes gauge") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("# TYPE makerapi_uptime_seconds gauge") !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("# TYPE makerapi_loop_longest_gap_seconds "
+                                  "gauge") != std::string::npos);
+
+  // Routes without traffic are left out
+  TEST_ASSERT_TRUE(sink.text.find("path=\"/metrics\"") == std::string::npos);
+
+  // The checker itself rejects malformed output
+  TEST_ASSERT_TRUE(checkPrometheusFormat("foo 1\n").length() > 0);
+  TEST_ASSERT_TRUE(
+      checkPrometheusFormat("# TYPE foo gauge\nfoo{a=\"b} 1\n").length() > 0);
+  TEST_ASSERT_TRUE(
+      checkPrometheusFormat("# TYPE foo gauge\nfoo 1 123\n").length() > 0);
+}
+
+// Test the Prometheus route serves a full route table whole, past the
+// capped up-front reserve
+static void test_prometheus_route_full_table() {
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  RouteMetrics &metrics = module.getMetrics();
+  for (size_t i = metrics.size(); i < RouteMetrics::kMaxRoutes; i++) {
+    String path = "/r" + String(static_cast<unsigned int>(i));
+    metrics.registerRoute("Test", path.c_str(), "GET");
+  }
+  for (size_t i = 0; i < RouteMetrics::kMaxRoutes; i++) {
+    metrics.record(static_cast<int>(i), 100, 0);
+  }
+
+  RequestT req;
+  ResponseT res;
+  routes[13].getWebRoute().unifiedHandler(req, res);
+  TEST_ASSERT_EQUAL(200, res.getStatus());
+  const std::string body = res.getContent().c_str();
+  TEST_ASSERT_TRUE(body.length() > MAKER_API_PROMETHEUS_RESERVE_BYTES);
+  const std::string error = checkPrometheusFormat(body);
+  TEST_ASSERT_EQUAL_STRING("", error.c_str());
+  TEST_ASSERT_TRUE(body.find("path=\"/r15\"") != std::string::npos);
+  TEST_ASSERT_TRUE(body.find("# TYPE makerapi_uptime_seconds gauge") !=
+                   std::string::npos);
+}
+
+// Test heap telemetry against a fake allocator: fragmentation ratio, sampling
+// from handle() and the history ring
+static void test_heap_telemetry() {
+  HeapStats stats = {};
+  TEST_ASSERT_EQUAL(0, stats.fragmentationPercent()); // No free heap at all
+  stats.freeBytes = 200000;
+  stats.largestFreeBlock = 150000;
+  TEST_ASSERT_EQUAL(25, stats.fragmentationPercent());
+  stats.largestFreeBlock = 200000;
+  TEST_ASSERT_EQUAL(0, stats.fragmentationPercent());
+
+  FakeHeapStatsProvider fake;
+  fake.stats.freeBytes = 180000;
+  fake.stats.largestFreeBlock = 90000;
+  fake.stats.minFreeBytes = 150000;
+  fake.stats.totalBytes = 320000;
+  testModule->setHeapStatsProvider(&fake);
+
+  // The first handle() samples straight away; the next waits an interval
+  testModule->handle();
+  fake.stats.freeBytes = 170000;
+  testModule->handle();
+
+  const HeapHistory &history = testModule->getHeapHistory();
+  TEST_ASSERT_EQUAL(1, history.totalAdded());
+  HeapHistory::Sample samples[HeapHistory::kSamples];
+  TEST_ASSERT_EQUAL(1, history.copy(samples, HeapHistory::kSamples));
+  TEST_ASSERT_EQUAL(180000, samples[0].freeBytes);
+  TEST_ASSERT_EQUAL(90000, samples[0].largestFreeBlock);
+  TEST_ASSERT_EQUAL(150000, samples[0].minFreeBytes);
+
+  // The ring keeps the newest samples, oldest first
+  HeapHistory ring;
+  for (uint32_t i = 0; i < HeapHistory::kSamples + 5; i++) {
+    HeapHistory::Sample sample = {};
+    sample.uptimeSeconds = i;
+    ring.add(sample);
+  }
+  TEST_ASSERT_EQUAL(HeapHistory::kSamples,
+                    ring.copy(samples, HeapHistory::kSamples));
+  TEST_ASSERT_EQUAL(5, samples[0].uptimeSeconds);
+  TEST_ASSERT_EQUAL(HeapHistory::kSamples + 4,
+                    samples[HeapHistory::kSamples - 1].uptimeSeconds);
+  TEST_ASSERT_EQUAL(3, ring.copy(samples, 3));
+  TEST_ASSERT_EQUAL(HeapHistory::kSamples + 2, samples[0].uptimeSeconds);
+
+  // Prometheus reports the provider's figures
+  StdStringSink sink;
+  testModule->writePrometheusMetrics(sink);
+  TEST_ASSERT_TRUE(sink.text.find("makerapi_heap_free_bytes "
+                                  "170000.000000\n") != std::string::npos);
+  TEST_ASSERT_TRUE(sink.text.find("makerapi_heap_fragmentation_ratio "
+                                  "0.480000\n") != std::string::npos);
+
+  testModule->setHeapStatsProvider(nullptr);
+}
+
+// Test the per-request JSON arena: in-place growth and reuse, heap fallback
+// when full or already leased, high-water marks and the /api/metrics report
+static void test_json_arena() {
+  JsonArena arena(256);
+  {
+    JsonArena::Lease lease(arena);
+    TEST_ASSERT_EQUAL_PTR(&arena, lease.allocator());
+
+    // A second response while the first holds the arena uses the heap
+    JsonArena::Lease contended(arena);
+    TEST_ASSERT_TRUE(contended.allocator() != &arena);
+
+    // The newest block grows in place and is reused once freed
+    char *block = static_cast<char *>(arena.allocate(10));
+    strcpy(block, "arena");
+    TEST_ASSERT_EQUAL_PTR(block, arena.reallocate(block, 40));
+    TEST_ASSERT_EQUAL_STRING("arena", block);
+    arena.deallocate(block);
+    TEST_ASSERT_EQUAL_PTR(block, arena.allocate(16));
+
+    // Too big for what's left - served by the heap
+    void *large = arena.allocate(1024);
+    TEST_ASSERT_NOT_NULL(large);
+    arena.deallocate(large);
+  }
+
+  JsonArena::Stats stats = arena.getStats();
+  TEST_ASSERT_EQUAL(256, stats.capacity);
+  TEST_ASSERT_EQUAL(1, stats.leases);
+  TEST_ASSERT_EQUAL(1, stats.overflows);
+  TEST_ASSERT_EQUAL(1, stats.contended);
+  TEST_ASSERT_TRUE(stats.lastUsed >= 40 && stats.lastUsed <= 256);
+  TEST_ASSERT_EQUAL(stats.lastUsed, stats.highWater);
+
+  // The reset makes the whole arena available to the next lease
+  {
+    JsonArena::Lease lease(arena);
+    TEST_ASSERT_NOT_NULL(arena.allocate(8));
+  }
+  stats = arena.getStats();
+  TEST_ASSERT_EQUAL(2, stats.leases);
+  TEST_ASSERT_TRUE(stats.lastUsed < stats.highWater);
+
+  // ArduinoJson documents build and serialize in it
+  JsonArena docArena(16384);
+  {
+    JsonArena::Lease lease(docArena);
+    JsonDocument doc(lease.allocator());
+    doc["name"] = String("copied into the arena");
+    doc["values"].add(1);
+    doc["values"].add(2);
+    String json;
+    serializeJson(doc, json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"name\":\"copied into the arena\",\"values\":[1,2]}",
+        json.c_str());
+  }
+  stats = docArena.getStats();
+  TEST_ASSERT_EQUAL(0, stats.overflows);
+  TEST_ASSERT_TRUE(stats.highWater > 0);
+
+  // The module's JSON routes lease its arena, reported by /api/metrics
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  RequestT req;
+  ResponseT configRes;
+  routes[5].getApiRoute().webRoute.unifiedHandler(req, configRes);
+  TEST_ASSERT_EQUAL(1, module.getJsonArenaStats().leases);
+
+  ResponseT metricsRes;
+  routes[6].getApiRoute().webRoute.unifiedHandler(req, metricsRes);
+  JsonDocument metricsJson;
+  TEST_ASSERT_FALSE(
+      deserializeJson(metricsJson, metricsRes.getContent().c_str()));
+  JsonObject report = metricsJson["jsonArena"];
+  TEST_ASSERT_EQUAL(MAKER_API_JSON_ARENA_SIZE, report["capacity"] | 0);
+  TEST_ASSERT_EQUAL(1, report["leases"] | 0);
+  TEST_ASSERT_TRUE((report["highWater"] | 0) > 0);
+  TEST_ASSERT_EQUAL(2, module.getJsonArenaStats().leases);
+
+  // begin() calibrated the heap delta; the native free-heap stub is cheap
+  TEST_ASSERT_TRUE(metricsJson["heapDelta"]["enabled"] | false);
+  TEST_ASSERT_EQUAL(module.getMetrics().getHeapSampleNanos(),
+                    metricsJson["heapDelta"]["sampleNs"] | 0u);
+}
+
+// Test the request trace ring: off by default, newest events kept oldest
+// first, and partial copies return the newest
+static void test_request_trace() {
+  TEST_ASSERT_FALSE(testModule->getRequestTrace().isEnabled());
+  testModule->setRequestTracing(true);
+  TEST_ASSERT_TRUE(testModule->getRequestTrace().isEnabled());
+  testModule->setRequestTracing(false);
+
+  RequestTrace trace;
+  RequestTrace::Event events[RequestTrace::kSlots];
+  TEST_ASSERT_EQUAL(0, trace.copy(events, RequestTrace::kSlots));
+  TEST_ASSERT_TRUE(trace.setEnabled(true)); // Allocates the ring
+
+  for (uint32_t i = 0; i < RequestTrace::kSlots + 3; i++) {
+    RequestTrace::Event event = {};
+    snprintf(event.method, sizeof(event.method), "GET");
+    snprintf(event.path, sizeof(event.path), "/config");
+    event.startMicros = 1000000ULL * i;
+    event.durationMicros = i;
+    event.status = 200;
+    event.bytes = 96;
+    trace.record(event);
+  }
+  TEST_ASSERT_EQUAL(RequestTrace::kSlots + 3, trace.totalRecorded());
+
+  TEST_ASSERT_EQUAL(RequestTrace::kSlots,
+                    trace.copy(events, RequestTrace::kSlots));
+  TEST_ASSERT_EQUAL(3, events[0].durationMicros);
+  TEST_ASSERT_EQUAL(RequestTrace::kSlots + 2,
+                    events[RequestTrace::kSlots - 1].durationMicros);
+  TEST_ASSERT_EQUAL_STRING("/config", events[0].path);
+  TEST_ASSERT_EQUAL(200, events[0].status);
+
+  TEST_ASSERT_EQUAL(2, trace.copy(events, 2));
+  TEST_ASSERT_EQUAL(RequestTrace::kSlots + 1, events[0].durationMicros);
+  TEST_ASSERT_EQUAL(1000000ULL * (RequestTrace::kSlots + 2),
+                    events[1].startMicros);
+}
+
+// Test the module's buffers go through the injected allocator: PSRAM first
+// except the atomically updated metrics table, internal RAM without PSRAM,
+// graceful degradation when nothing can be allocated, freed with the module
+static void test_buffer_allocator() {
+  FakeBufferAllocator buffers; // Outlives the modules below
+  buffers.psramCapacity = 64 * 1024;
+  {
+    MakerAPIModule module(mockProvider.get());
+    module.setBufferAllocator(&buffers);
+    module.begin();
+    TEST_ASSERT_EQUAL(0, buffers.liveBuffers()); // All allocated on first use
+
+    std::vector<RouteVariant> routes = module.getHttpRoutes();
+    TEST_ASSERT_TRUE(module.setRequestTracing(true));
+    module.handle();
+    RequestT req;
+    ResponseT res;
+    routes[5].getApiRoute().webRoute.unifiedHandler(req, res);
+
+    // Metrics table, trace ring, heap history and JSON arena
+    TEST_ASSERT_EQUAL(4, buffers.liveBuffers());
+    TEST_ASSERT_TRUE(buffers.internalBytes() > 0); // Metrics table
+    TEST_ASSERT_TRUE(buffers.psramBytes() >
+                     RequestTrace::kSlots * sizeof(RequestTrace::Event) +
+                         MAKER_API_JSON_ARENA_SIZE);
+    TEST_ASSERT_EQUAL(1, module.getRequestTrace().totalRecorded());
+    TEST_ASSERT_EQUAL(1, module.getHeapHistory().totalAdded());
+
+    // /api/heap and /api/trace copy into buffers freed with the response
+    ResponseT heapRes;
+    routes[8].getApiRoute().webRoute.unifiedHandler(req, heapRes);
+    ResponseT traceRes;
+    routes[9].getApiRoute().webRoute.unifiedHandler(req, traceRes);
+    JsonDocument heap;
+    TEST_ASSERT_FALSE(deserializeJson(heap, heapRes.getContent().c_str()));
+    TEST_ASSERT_EQUAL(1, heap["samples"].size());
+    JsonDocument trace;
+    TEST_ASSERT_FALSE(deserializeJson(trace, traceRes.getContent().c_str()));
+    TEST_ASSERT_TRUE(trace["traceEvents"].size() >= 2); // Track name + event
+    TEST_ASSERT_EQUAL(4, buffers.liveBuffers());
+  }
+  TEST_ASSERT_EQUAL(0, buffers.liveBuffers());
+
+  // No PSRAM: everything lands in internal RAM
+  buffers.psramCapacity = 0;
+  {
+    MakerAPIModule module(mockProvider.get());
+    module.setBufferAllocator(&buffers);
+    module.getHttpRoutes();
+    TEST_ASSERT_TRUE(module.setRequestTracing(true));
+    TEST_ASSERT_EQUAL(2, buffers.liveBuffers());
+    TEST_ASSERT_EQUAL(0, buffers.psramBytes());
+  }
+
+  // Nothing to allocate: routes are served uninstrumented, tracing stays off
+  buffers.failAll = true;
+  {
+    MakerAPIModule module(mockProvider.get());
+    module.setBufferAllocator(&buffers);
+    std::vector<RouteVariant> routes = module.getHttpRoutes();
+    TEST_ASSERT_EQUAL(18, routes.size());
+    TEST_ASSERT_EQUAL(0, module.getMetrics().size());
+    TEST_ASSERT_TRUE(module.getMetrics().getDroppedRegistrations() > 0);
+    TEST_ASSERT_FALSE(module.setRequestTracing(true));
+    TEST_ASSERT_FALSE(module.getRequestTrace().isEnabled());
+
+    RequestT req;
+    ResponseT res;
+    routes[5].getApiRoute().webRoute.unifiedHandler(req, res);
+    JsonDocument config;
+    TEST_ASSERT_FALSE(deserializeJson(config, res.getContent().c_str()));
+    TEST_ASSERT_EQUAL(1, module.getJsonArenaStats().leases);
+    TEST_ASSERT_TRUE(module.getJsonArenaStats().overflows > 0);
+
+    // Without its working copy the heap history asks the client to retry
+    ResponseT heapRes;
+    routes[8].getApiRoute().webRoute.unifiedHandler(req, heapRes);
+    TEST_ASSERT_EQUAL(503, heapRes.getStatus());
+    TEST_ASSERT_EQUAL_STRING("10", heapRes.getHeader("Retry-After").c_str());
+  }
+  TEST_ASSERT_EQUAL(0, buffers.liveBuffers());
+}
+
+// POST body to route and parse its JSON reply; returns the status
+static int postJson(const WebRoute &route, const String &body,
+                    JsonDocument &reply) {
+  RequestT req;
+  req.setBody(body);
+  ResponseT res;
+  route.unifiedHandler(req, res);
+  TEST_ASSERT_FALSE(deserializeJson(reply, res.getContent().c_str()));
+  return res.getStatus();
+}
+
+// Routes another module instruments, for the batch and benchmark tests: an
+// echo of the call's body and X-Test header, a parameterized route and one
+// that only accepts a session
+static std::vector<RouteVariant> instrumentTestRoutes(MakerAPIModule &module,
+                                                      size_t &privateCalls) {
+  std::vector<RouteVariant> routes;
+  routes.push_back(WebRoute(
+      "/echo", WebModule::WM_POST,
+      [](RequestT &req, ResponseT &res) {
+        res.setContent(String("{\"body\":") + req.getBody() +
+                           ",\"header\":\"" + req.getHeader("X-Test") + "\"}",
+                       "application/json");
+      },
+      {AuthType::NONE}));
+  routes.push_back(WebRoute(
+      "/items/{id}", WebModule::WM_GET,
+      [](RequestT &req, ResponseT &res) {
+        res.setContent(String("{\"id\":\"") + req.getParam("id") + "\"}",
+                       "application/json");
+      },
+      {AuthType::NONE}));
+  routes.push_back(WebRoute(
+      "/private", WebModule::WM_GET,
+      [&privateCalls](RequestT &, ResponseT &res) {
+        privateCalls++;
+        res.setContent("{}", "application/json");
+      },
+      {AuthType::SESSION}));
+  return module.instrumentRoutes("Test", routes);
+}
+
+// Test /api/batch runs each call with its own body, headers and path
+// parameters, refuses calls whose auth it can't check while still running
+// the rest of the batch, and enforces the call limit
+static void test_batch_calls() {
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  size_t privateCalls = 0;
+  instrumentTestRoutes(module, privateCalls);
+  const WebRoute batch = routes[11].getApiRoute().webRoute;
+
+  JsonDocument reply;
+  TEST_ASSERT_EQUAL(
+      200, postJson(batch,
+                    "[{\"method\": \"GET\", \"path\": \"/api/metrics\"},"
+                    " {\"method\": \"POST\", \"path\": \"/x/api/echo\","
+                    "  \"headers\": {\"X-Test\": \"yes\"}, \"body\": {\"a\": 1}},"
+                    " {\"method\": \"POST\", \"path\": \"/echo\", \"body\": \"7\"},"
+                    " {\"method\": \"GET\", \"path\": \"/items/42\"}]",
+                    reply));
+  JsonArray responses = reply["responses"];
+  TEST_ASSERT_EQUAL(4, responses.size());
+  TEST_ASSERT_EQUAL(200, responses[0]["status"] | 0);
+  TEST_ASSERT_TRUE(responses[0]["body"]["success"] | false);
+  TEST_ASSERT_EQUAL(1, responses[1]["body"]["body"]["a"] | 0);
+  TEST_ASSERT_EQUAL_STRING("yes", responses[1]["body"]["header"] | "");
+  TEST_ASSERT_EQUAL(7, responses[2]["body"]["body"] | 0);
+  TEST_ASSERT_EQUAL_STRING("", responses[2]["body"]["header"] | "?");
+  TEST_ASSERT_EQUAL_STRING("42", responses[3]["body"]["id"] | "");
+
+  // Dispatched through the instrumented handlers
+  RouteMetrics::Snapshot snapshot;
+  TEST_ASSERT_TRUE(module.getMetrics().snapshot(1, snapshot));
+  TEST_ASSERT_EQUAL_STRING("/metrics", snapshot.path);
+  TEST_ASSERT_EQUAL(1, snapshot.count);
+
+  // Mixed auth: the session-only route is refused (and not run), the call
+  // after it still runs, and per-call credentials are rejected
+  TEST_ASSERT_EQUAL(
+      200, postJson(batch,
+                    "[{\"path\": \"/private\"},"
+                    " {\"path\": \"/items/7\"},"
+                    " {\"path\": \"/items/7\","
+                    "  \"headers\": {\"Authorization\": \"Bearer x\"}},"
+                    " {\"path\": \"/missing\"}]",
+                    reply));
+  responses = reply["responses"];
+  TEST_ASSERT_EQUAL(403, responses[0]["status"] | 0);
+  TEST_ASSERT_TRUE(responses[0]["error"].is<const char *>());
+  TEST_ASSERT_EQUAL(0, privateCalls);
+  TEST_ASSERT_EQUAL(200, responses[1]["status"] | 0);
+  TEST_ASSERT_EQUAL_STRING("7", responses[1]["body"]["id"] | "");
+  TEST_ASSERT_EQUAL(400, responses[2]["status"] | 0);
+  TEST_ASSERT_EQUAL(404, responses[3]["status"] | 0);
+
+  // At most MAKER_API_BATCH_MAX_CALLS calls
+  String calls = "[";
+  for (size_t i = 0; i <= MAKER_API_BATCH_MAX_CALLS; i++) {
+    calls += i ? ", " : "";
+    calls += "{\"path\": \"/items/1\"}";
+  }
+  calls += "]";
+  TEST_ASSERT_EQUAL(413, postJson(batch, calls, reply));
+  TEST_ASSERT_FALSE(reply["success"] | true);
+  TEST_ASSERT_EQUAL(400, postJson(batch, "{}", reply));
+
+  // The docs quote the configured limit
+  TEST_ASSERT_TRUE(module.getBatchDocs().getDescription().indexOf(
+                       String("at most ") + MAKER_API_BATCH_MAX_CALLS) >= 0);
+}
+
+// Test /api/benchmark against a real instrumented route: the iteration
+// count and its clamping, the call's path parameters, and that benchmark
+// runs stay out of the route metrics
+static void test_benchmark_route() {
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  size_t privateCalls = 0;
+  instrumentTestRoutes(module, privateCalls);
+  const WebRoute benchmark = routes[12].getApiRoute().webRoute;
+  const uint32_t generation = module.getMetrics().getGeneration();
+
+  JsonDocument reply;
+  TEST_ASSERT_EQUAL(
+      200, postJson(benchmark,
+                    "{\"method\": \"GET\", \"path\": \"/items/42\", "
+                    "\"iterations\": 5}",
+                    reply));
+  TEST_ASSERT_EQUAL_STRING("/items/{id}", reply["route"]["path"] | "");
+  TEST_ASSERT_EQUAL(5, reply["summary"]["iterations"] | 0);
+  TEST_ASSERT_EQUAL(5, reply["iterations"].size());
+  TEST_ASSERT_EQUAL(strlen("{\"id\":\"42\"}"), reply["summary"]["bytes"] | 0);
+
+  // Clamped to [1, kMaxIterations]; 20 when omitted
+  postJson(benchmark, "{\"path\": \"/items/1\", \"iterations\": -3}", reply);
+  TEST_ASSERT_EQUAL(1, reply["summary"]["iterations"] | 0);
+  postJson(benchmark, "{\"path\": \"/items/1\", \"iterations\": 0}", reply);
+  TEST_ASSERT_EQUAL(1, reply["summary"]["iterations"] | 0);
+  postJson(benchmark, "{\"path\": \"/items/1\", \"iterations\": 100000}",
+           reply);
+  TEST_ASSERT_EQUAL(HandlerBenchmark::kMaxIterations,
+                    reply["summary"]["iterations"] | 0);
+  postJson(benchmark, "{\"path\": \"/items/1\"}", reply);
+  TEST_ASSERT_EQUAL(20, reply["summary"]["iterations"] | 0);
+
+  // The echo route gets the call's body on every iteration
+  postJson(benchmark,
+           "{\"method\": \"POST\", \"path\": \"/echo\", \"body\": [1, 2], "
+           "\"iterations\": 2}",
+           reply);
+  TEST_ASSERT_EQUAL(strlen("{\"body\":[1,2],\"header\":\"\"}"),
+                    reply["summary"]["bytes"] | 0);
+
+  // Refused routes are never run
+  TEST_ASSERT_EQUAL(403, postJson(benchmark, "{\"path\": \"/private\"}", reply));
+  TEST_ASSERT_EQUAL(0, privateCalls);
+
+  // None of it reached the metrics table
+  TEST_ASSERT_EQUAL(generation, module.getMetrics().getGeneration());
+  RouteMetrics::Snapshot snapshot;
+  for (size_t i = 0; i < module.getMetrics().size(); i++) {
+    TEST_ASSERT_TRUE(module.getMetrics().snapshot(i, snapshot));
+    TEST_ASSERT_EQUAL(0, snapshot.count);
+  }
+}
+
+// Test the handler benchmark against a fake heap: per-iteration heap delta
+// and size, the iteration cap, the time budget and the summary ordering
+static void test_handler_benchmark() {
+  FakeHeapStatsProvider fake;
+  fake.stats.freeBytes = 100000;
+
+  static HandlerBenchmark benchmark;
+  size_t calls = 0;
+  auto leakyHandler = [&fake, &calls]() {
+    calls++;
+    fake.stats.freeBytes -= 64; // Leaks 64 bytes per call
+    return static_cast<size_t>(100 + calls);
+  };
+
+  TEST_ASSERT_EQUAL(10, benchmark.run(fake, 10, 1000000, leakyHandler));
+  TEST_ASSERT_EQUAL(10, calls);
+  TEST_ASSERT_EQUAL(64, benchmark.iteration(0).heapDelta);
+  TEST_ASSERT_EQUAL(101, benchmark.iteration(0).bytes);
+  TEST_ASSERT_EQUAL(110, benchmark.iteration(9).bytes);
+
+  const HandlerBenchmark::Summary summary = benchmark.summarize();
+  TEST_ASSERT_EQUAL(10, summary.iterations);
+  TEST_ASSERT_EQUAL(64, summary.heapDeltaMax);
+  TEST_ASSERT_EQUAL(110, summary.bytes);
+  TEST_ASSERT_TRUE(summary.minMicros <= summary.p50Micros);
+  TEST_ASSERT_TRUE(summary.p50Micros <= summary.p90Micros);
+  TEST_ASSERT_TRUE(summary.p90Micros <= summary.maxMicros);
+
+  // Capped at kMaxIterations; a spent budget still runs once
+  calls = 0;
+  TEST_ASSERT_EQUAL(HandlerBenchmark::kMaxIterations,
+                    benchmark.run(fake, HandlerBenchmark::kMaxIterations + 5,
+                                  UINT32_MAX, leakyHandler));
+  TEST_ASSERT_EQUAL(1, benchmark.run(fake, 10, 0, leakyHandler));
+  TEST_ASSERT_EQUAL(1, benchmark.summarize().iterations);
+}
+
+// Check one measurement against its kAllocBudgets entry plus the margin,
+// printing it in the form tools/update_alloc_budgets.py reads. Until the
+// entries are measured only their presence is checked.
+static void checkAllocBudget(const char *name, const AllocStats &stats) {
+  const AllocBudget *budget = nullptr;
+  for (const AllocBudget &entry : kAllocBudgets) {
+    if (strcmp(entry.name, name) == 0) {
+      budget = &entry;
+    }
+  }
+
+  char message[160];
+  snprintf(message, sizeof(message), "ALLOC_MEASURED \"%s\" %zu %zu", name,
+           stats.allocations, stats.peakBytes);
+  TEST_MESSAGE(message);
+  if (!budget) {
+    snprintf(message, sizeof(message), "No allocation budget for %s", name);
+    TEST_FAIL_MESSAGE(message);
+  }
+  if (!MAKER_API_ALLOC_BUDGETS_MEASURED) {
+    return;
+  }
+
+  const size_t maxAllocations = MAKER_API_ALLOC_MARGIN(budget->allocations, 2);
+  const size_t maxPeakBytes = MAKER_API_ALLOC_MARGIN(budget->peakBytes, 256);
+  snprintf(message, sizeof(message),
+           "%s: %zu allocations, %zu peak bytes over the budget of %zu, %zu",
+           name, stats.allocations, stats.peakBytes, maxAllocations,
+           maxPeakBytes);
+  TEST_ASSERT_TRUE_MESSAGE(stats.allocations <= maxAllocations, message);
+  TEST_ASSERT_TRUE_MESSAGE(stats.peakBytes <= maxPeakBytes, message);
+}
+
+// Test route construction and one call of every route handler against the
+// heap budgets in alloc_budgets.h
+static void test_allocation_budgets() {
+  if (!AllocScope::supported()) {
+    TEST_IGNORE_MESSAGE("Allocations can't be tracked on this platform");
+  }
+
+  // Handlers need a platform, which the default-constructed fixture lacks
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  module.getHttpRoutes(); // First build registers the metrics slots
+
+  std::vector<RouteVariant> routes;
+  AllocStats stats;
+  {
+    AllocScope scope;
+    routes = module.getHttpRoutes();
+    stats = scope.stats();
+  }
+  checkAllocBudget("getHttpRoutes", stats);
+
+  for (const RouteVariant &route : routes) {
+    const WebRoute webRoute =
+        route.isApiRoute() ? route.getApiRoute().webRoute : route.getWebRoute();
+    const String name =
+        String(webRoute.method == WebModule::WM_POST ? "POST " : "GET ") +
+        (route.isApiRoute() ? "/api" : "") + webRoute.path;
+
+    RequestT req;
+    ResponseT res;
+    {
+      AllocScope scope;
+      webRoute.unifiedHandler(req, res);
+      stats = scope.stats();
+    }
+    checkAllocBudget(name.c_str(), stats);
+  }
+
+  if (!MAKER_API_ALLOC_BUDGETS_MEASURED) {
+    TEST_IGNORE_MESSAGE("Allocation budgets not measured yet - run "
+                        "tools/update_alloc_budgets.py (see alloc_budgets.h)");
+  }
 }
 
 // Test module integration with platform
@@ -321,7 +1803,28 @@ void register_maker_api_tests() {
   RUN_TEST(test_get_platform_helper);
   RUN_TEST(test_openapi_config_handler_with_flags);
   RUN_TEST(test_static_asset_routes);
+  RUN_TEST(test_asset_version_fingerprint);
+  RUN_TEST(test_feature_asset_routes);
+  RUN_TEST(test_baked_spec);
+  RUN_TEST(test_baked_spec_page_token);
+  RUN_TEST(test_baked_spec_matches_runtime);
+  RUN_TEST(test_api_routes_instrumented);
+  RUN_TEST(test_route_metrics_recording);
+  RUN_TEST(test_latency_histogram_buckets);
+  RUN_TEST(test_latency_histogram_percentiles);
+  RUN_TEST(test_loop_timing);
+  RUN_TEST(test_metrics_stream_events);
+  RUN_TEST(test_prometheus_metrics_format);
+  RUN_TEST(test_prometheus_route_full_table);
+  RUN_TEST(test_heap_telemetry);
+  RUN_TEST(test_json_arena);
+  RUN_TEST(test_request_trace);
+  RUN_TEST(test_buffer_allocator);
+  RUN_TEST(test_batch_calls);
+  RUN_TEST(test_benchmark_route);
+  RUN_TEST(test_handler_benchmark);
+  RUN_TEST(test_allocation_budgets);
   RUN_TEST(test_module_platform_integration);
 }
 
-#endif // NATIVE_PLATFORM
+#endif // NATIVE_PLATFORM && !MAKER_API_HEADLESS
@@ -0,0 +1,161 @@
+#include <unity.h>
+
+#if defined(NATIVE_PLATFORM) && MAKER_API_HEADLESS
+
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+
+#include <memory>
+#include <vector>
+
+#include <testing/testing_platform_provider.h>
+
+#include <maker_api.h>
+
+// Same fixture as test/native: a mock platform for every test
+static std::unique_ptr<MockWebPlatformProvider> mockProvider;
+
+extern "C" void setUp(void) {
+  ArduinoFakeReset();
+  mockProvider = std::make_unique<MockWebPlatformProvider>();
+  IWebPlatformProvider::instance = mockProvider.get();
+}
+
+extern "C" void tearDown(void) {
+  mockProvider.reset();
+  IWebPlatformProvider::instance = nullptr;
+}
+
+static WebRoute webRouteOf(const RouteVariant &route) {
+  return route.isApiRoute() ? route.getApiRoute().webRoute
+                            : route.getWebRoute();
+}
+
+// Test headless registers only the index and the config route
+static void test_headless_routes() {
+  MakerAPIModule module(mockProvider.get());
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  TEST_ASSERT_EQUAL(2, routes.size());
+  TEST_ASSERT_TRUE(routes[0].isWebRoute());
+  TEST_ASSERT_EQUAL_STRING("/", routes[0].getWebRoute().path.c_str());
+  TEST_ASSERT_TRUE(routes[1].isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/config",
+                           routes[1].getApiRoute().webRoute.path.c_str());
+  TEST_ASSERT_EQUAL(WebModule::WM_POST, routes[1].getApiRoute().webRoute.method);
+  TEST_ASSERT_EQUAL(0, module.getAssetVersion().length());
+}
+
+// Test the index is served from the body cached in begin(), with absolute
+// links and an ETag that revalidates to a 304
+static void test_headless_index() {
+  MakerAPIModule module(mockProvider.get());
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  const WebRoute index = webRouteOf(routes[0]);
+
+  // Nothing is cached before begin()
+  RequestT req;
+  ResponseT early;
+  index.unifiedHandler(req, early);
+  TEST_ASSERT_EQUAL(503, early.getStatus());
+
+  module.setBasePath("/tools/api");
+  module.begin();
+
+  ResponseT res;
+  index.unifiedHandler(req, res);
+  TEST_ASSERT_EQUAL(200, res.getStatus());
+  const String etag = res.getHeader("ETag");
+  TEST_ASSERT_TRUE(etag.startsWith("\""));
+  TEST_ASSERT_EQUAL(10, etag.length());
+
+  JsonDocument doc;
+  TEST_ASSERT_FALSE(deserializeJson(doc, res.getContent().c_str()));
+  TEST_ASSERT_EQUAL_STRING("Maker API", doc["name"] | "");
+  TEST_ASSERT_EQUAL_STRING(WEB_MODULE_VERSION_STR, doc["version"] | "");
+  TEST_ASSERT_EQUAL_STRING("/openapi.json", doc["specs"]["full"] | "");
+  TEST_ASSERT_EQUAL_STRING("/maker/openapi.json", doc["specs"]["maker"] | "");
+  TEST_ASSERT_EQUAL_STRING("/tools/api/api/config",
+                           doc["config"]["href"] | "");
+  TEST_ASSERT_EQUAL_STRING("POST", doc["config"]["method"] | "");
+
+  // Revalidation: a 304 without the body
+  RequestT revalidate;
+  revalidate.setHeader("If-None-Match", etag);
+  ResponseT notModified;
+  index.unifiedHandler(revalidate, notModified);
+  TEST_ASSERT_EQUAL(304, notModified.getStatus());
+  TEST_ASSERT_EQUAL(0, notModified.getContent().length());
+  TEST_ASSERT_EQUAL_STRING(etag.c_str(),
+                           notModified.getHeader("ETag").c_str());
+
+  RequestT stale;
+  stale.setHeader("If-None-Match", "\"00000000\"");
+  ResponseT fresh;
+  index.unifiedHandler(stale, fresh);
+  TEST_ASSERT_EQUAL(200, fresh.getStatus());
+  TEST_ASSERT_EQUAL_STRING(res.getContent().c_str(),
+                           fresh.getContent().c_str());
+}
+
+// Test a baked spec is linked under the base path, like the config
+static void test_headless_index_baked_spec() {
+  MakerAPIModule module(mockProvider.get());
+  module.setBakedSpec("{\"openapi\":\"3.0.3\",\"paths\":{}}");
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  TEST_ASSERT_EQUAL(3, routes.size());
+
+  RequestT req;
+  ResponseT res;
+  webRouteOf(routes[0]).unifiedHandler(req, res);
+  JsonDocument doc;
+  TEST_ASSERT_FALSE(deserializeJson(doc, res.getContent().c_str()));
+  TEST_ASSERT_EQUAL_STRING(MAKER_API_BASE_PATH "/openapi.json",
+                           doc["specs"]["maker"] | "");
+  TEST_ASSERT_EQUAL_STRING(MAKER_API_BASE_PATH "/api/config",
+                           doc["config"]["href"] | "");
+}
+
+// Test /api/config is the cached configuration, without an asset version,
+// revalidated by its own ETag
+static void test_headless_config() {
+  MakerAPIModule module(mockProvider.get());
+  module.begin();
+  std::vector<RouteVariant> routes = module.getHttpRoutes();
+  const WebRoute config = webRouteOf(routes[1]);
+
+  RequestT req;
+  ResponseT res;
+  config.unifiedHandler(req, res);
+  TEST_ASSERT_EQUAL(200, res.getStatus());
+  JsonDocument doc;
+  TEST_ASSERT_FALSE(deserializeJson(doc, res.getContent().c_str()));
+  TEST_ASSERT_TRUE(doc["success"] | false);
+  TEST_ASSERT_TRUE(doc["assetVersion"].isNull());
+  TEST_ASSERT_TRUE(doc["OpenApiConfig"]["makerSpec"] | false);
+  TEST_ASSERT_EQUAL(0, doc["features"].size());
+
+  const String etag = res.getHeader("ETag");
+  TEST_ASSERT_EQUAL(10, etag.length());
+
+  // Instrumented: the first request was counted
+  RouteMetrics::Snapshot snapshot;
+  TEST_ASSERT_TRUE(module.getMetrics().snapshot(0, snapshot));
+  TEST_ASSERT_EQUAL(1, snapshot.count);
+
+  RequestT revalidate;
+  revalidate.setHeader("If-None-Match", etag);
+  ResponseT notModified;
+  config.unifiedHandler(revalidate, notModified);
+  TEST_ASSERT_EQUAL(304, notModified.getStatus());
+  TEST_ASSERT_EQUAL(0, notModified.getContent().length());
+}
+
+void register_maker_api_tests() {
+  RUN_TEST(test_headless_routes);
+  RUN_TEST(test_headless_index);
+  RUN_TEST(test_headless_index_baked_spec);
+  RUN_TEST(test_headless_config);
+}
+
+#endif // NATIVE_PLATFORM && MAKER_API_HEADLESS
@@ -2,7 +2,8 @@
 
 #ifdef NATIVE_PLATFORM
 
-// Forward declaration from test/native/src/test_maker_api.cpp.
+// Forward declaration from test/native/src/test_maker_api.cpp (or
+// test/native_headless/src/test_maker_api_headless.cpp in the headless env).
 // setUp()/tearDown() also live there since maker_api's tests share one
 // MakerAPIModule/MockWebPlatformProvider fixture per test rather than
 // constructing local instances (unlike sibling modules' per-test pattern).
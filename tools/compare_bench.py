@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+compare_bench.py
+Compare two bench_native result files (bench_output.txt JSON) and flag
+regressions in time or allocations per operation.
+
+Exits with status 1 when any benchmark got slower than the threshold or
+allocates more per op, so it can gate CI.
+
+Usage:
+    python3 tools/compare_bench.py baseline.json bench_output.txt \
+        --threshold 10
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, "r", encoding="utf-8") as f:
+        data = json.load(f)
+    return {b["name"]: b for b in data.get("benchmarks", [])}
+
+
+def pct(old, new):
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    return (new - old) * 100.0 / old
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("baseline", help="Earlier bench_output.txt")
+    ap.add_argument("current", help="New bench_output.txt")
+    ap.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="Allowed ns/op increase in percent (default 10)",
+    )
+    args = ap.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    print(
+        f"{'benchmark':<24} {'ns/op':>12} {'delta':>8} "
+        f"{'allocs/op':>10} {'delta':>8}"
+    )
+    for name, new in current.items():
+        old = baseline.get(name)
+        if old is None:
+            print(f"{name:<24} {new['ns_per_op']:>12.1f} {'new':>8}")
+            continue
+
+        time_delta = pct(old["ns_per_op"], new["ns_per_op"])
+        alloc_delta = new["allocs_per_op"] - old["allocs_per_op"]
+        flag = ""
+        if time_delta > args.threshold or alloc_delta > 0.005:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(
+            f"{name:<24} {new['ns_per_op']:>12.1f} {time_delta:>+7.1f}% "
+            f"{new['allocs_per_op']:>10.2f} {alloc_delta:>+8.2f}{flag}"
+        )
+
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<24} {'removed':>12}")
+
+    if regressions:
+        print(f"\n{regressions} regression(s)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+"""
+size_report.py
+Report the flash and static RAM cost of compiled objects (or a linked ELF)
+per file, per embedded asset and per symbol, check it against a budget file
+and show the delta against a previous report.
+
+Sizes come from the section headers (so string literals and literal pools
+are counted) and the symbol table, both read with the toolchain's objdump.
+Object files are measured before linking, so code the linker would drop as
+unreferenced is still counted - an upper bound per file. Given --elf, the
+linked firmware is measured too: its flash and RAM are reported as
+"firmware" and the assets are taken from it, so only what was linked counts.
+
+Budgets are derived from a measured report: --write-budget turns this
+report into size_budget.json, allowing each measured value a margin
+(BUDGET_MARGIN_PERCENT, at least BUDGET_MARGIN_BYTES, rounded up to 256
+bytes). A budget file whose "measured" is not true was never produced that
+way; it is reported against but not enforced.
+
+Exits with status 1 when anything is over an enforced budget.
+
+Usage:
+    python3 tools/size_report.py --objdump xtensa-esp32s3-elf-objdump \
+        --budget size_budget.json --baseline size_baseline.json \
+        --output size_report.json .pio/build/esp32-s3-devkitc-1/src/*.o
+    python3 tools/size_report.py --objdump ... --elf firmware.elf \
+        --output size_baseline.json --write-budget size_budget.json *.o
+
+Normally run through the size_report target (scripts/size_report_target.py).
+"""
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+KINDS = ("code", "iram", "rodata", "data", "bss")
+
+# Headroom a derived budget gives each measured value
+BUDGET_MARGIN_PERCENT = 5
+BUDGET_MARGIN_BYTES = 256
+
+# Embedded web assets (assets/*.h) and the baked spec - PROGMEM is plain
+# .rodata on ESP32
+ASSET_RE = re.compile(r"^MAKER_API_\w+_(HTML|CSS|JS|JSON)$")
+
+# objdump -h: "  5 .rodata.str1.1  00000a3c  00000000 ..." then a flags line
+SECTION_RE = re.compile(r"^\s*\d+\s+(\S+)\s+([0-9a-fA-F]+)\s")
+
+# objdump -t: "00000000 g     O .rodata.X\t00001c9e X"
+SYMBOL_RE = re.compile(r"^[0-9a-fA-F]+\s(.{7})\s(\S+)\s+([0-9a-fA-F]+)\s+(.*)$")
+
+
+def section_kind(name):
+    """Map a section name to a cost kind, None for non-allocated ones."""
+    if name.startswith((".iram", ".iram0", ".iram1")):
+        return "iram"  # Code copied to RAM at boot - costs flash and RAM
+    if name.startswith((".text", ".flash.text", ".literal")):
+        return "code"
+    if name.startswith((".rodata", ".flash.rodata", ".irom")):
+        return "rodata"
+    if name.startswith((".data", ".sdata", ".dram0.data", ".dram1")):
+        return "data"
+    if name.startswith((".bss", ".sbss", ".dram0.bss", ".noinit")):
+        return "bss"
+    return None
+
+
+def totals_of(kinds):
+    """Flash holds code, rodata and the initial values of data and IRAM
+    code; RAM holds data, bss and IRAM code."""
+    result = {kind: kinds.get(kind, 0) for kind in KINDS}
+    result["flash"] = (
+        result["code"] + result["rodata"] + result["data"] + result["iram"]
+    )
+    result["ram"] = result["data"] + result["bss"] + result["iram"]
+    return result
+
+
+def objdump(tool, flag, path):
+    try:
+        return subprocess.run(
+            [tool, flag, "-C", path],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout
+    except FileNotFoundError:
+        sys.exit(f"size_report: {tool} not found - pass --objdump")
+    except subprocess.CalledProcessError as e:
+        sys.exit(f"size_report: {tool} failed on {path}: {e.stderr.strip()}")
+
+
+def measure_file(tool, path):
+    kinds = {}
+    lines = objdump(tool, "-h", path).splitlines()
+    for i, line in enumerate(lines):
+        m = SECTION_RE.match(line)
+        if not m or i + 1 >= len(lines) or "ALLOC" not in lines[i + 1]:
+            continue
+        kind = section_kind(m.group(1))
+        if kind:
+            kinds[kind] = kinds.get(kind, 0) + int(m.group(2), 16)
+
+    symbols = []
+    for line in objdump(tool, "-t", path).splitlines():
+        m = SYMBOL_RE.match(line)
+        if not m:
+            continue
+        flags, section, size, name = m.groups()
+        size = int(size, 16)
+        kind = section_kind(section)
+        # Skip debug/file/section symbols and anything that isn't allocated
+        if size == 0 or kind is None or "d" in flags or "f" in flags:
+            continue
+        symbols.append({"name": name.strip(), "kind": kind, "size": size})
+    return totals_of(kinds), symbols
+
+
+def linked_assets(symbols):
+    return {s["name"]: s["size"] for s in symbols if ASSET_RE.match(s["name"])}
+
+
+def build_report(tool, paths, top, elf=None):
+    files = {}
+    assets = {}
+    all_symbols = []
+    for path in sorted(paths):
+        name = os.path.basename(path)
+        files[name], symbols = measure_file(tool, path)
+        for symbol in symbols:
+            symbol["file"] = name
+            if ASSET_RE.match(symbol["name"]):
+                assets[symbol["name"]] = symbol["size"]
+        all_symbols.extend(symbols)
+
+    kinds = {k: sum(f[k] for f in files.values()) for k in KINDS}
+    all_symbols.sort(key=lambda s: s["size"], reverse=True)
+    report = {
+        "totals": totals_of(kinds),
+        "files": files,
+        "assets": dict(sorted(assets.items())),
+        "symbols": all_symbols[:top],
+    }
+    if elf:
+        report["firmware"], symbols = measure_file(tool, elf)
+        report["assets"] = dict(sorted(linked_assets(symbols).items()))
+    return report
+
+
+def budget_for(value):
+    """A measured value plus the margin, rounded up to 256 bytes."""
+    margin = max(value * BUDGET_MARGIN_PERCENT // 100, BUDGET_MARGIN_BYTES)
+    return (value + margin + 255) // 256 * 256
+
+
+def derive_budget(report, source):
+    """Budgets for every file, the totals and every asset of a report."""
+    budget = {
+        "measured": True,
+        "source": source,
+        "margin": {
+            "percent": BUDGET_MARGIN_PERCENT,
+            "minBytes": BUDGET_MARGIN_BYTES,
+        },
+        "totals": {
+            kind: budget_for(report["totals"][kind])
+            for kind in ("flash", "ram")
+        },
+        "files": {
+            name: {kind: budget_for(sizes[kind]) for kind in ("flash", "ram")}
+            for name, sizes in report["files"].items()
+        },
+        "assets": {
+            name: budget_for(size) for name, size in report["assets"].items()
+        },
+    }
+    if "firmware" in report:
+        budget["firmware"] = {
+            kind: budget_for(report["firmware"][kind])
+            for kind in ("flash", "ram")
+        }
+    return budget
+
+
+def fmt_delta(new, old):
+    if old is None:
+        return "new"
+    delta = new - old
+    return f"{delta:+d}" if delta else "="
+
+
+def check_budget(label, value, budget, failures):
+    if budget is None:
+        return ""
+    if value > budget:
+        failures.append(f"{label}: {value} > {budget}")
+        return f"  OVER BUDGET ({budget})"
+    return f"  {value * 100 // budget}% of {budget}"
+
+
+def print_report(report, budget, baseline):
+    failures = []
+    if budget and budget.get("measured") is not True:
+        print("size_budget.json was not derived from a measured report - "
+              "reported, not enforced (see --write-budget)\n")
+    old_files = baseline.get("files", {})
+    file_budgets = budget.get("files", {})
+
+    print(f"{'file':<28} {'flash':>8} {'delta':>8} {'ram':>7} {'delta':>7}")
+    for name, sizes in report["files"].items():
+        old = old_files.get(name, {})
+        limits = file_budgets.get(name, {})
+        print(
+            f"{name:<28} {sizes['flash']:>8} "
+            f"{fmt_delta(sizes['flash'], old.get('flash')):>8} "
+            f"{sizes['ram']:>7} {fmt_delta(sizes['ram'], old.get('ram')):>7}"
+            + check_budget(f"{name} flash", sizes["flash"], limits.get("flash"),
+                           failures)
+            + check_budget(f"{name} ram", sizes["ram"], limits.get("ram"),
+                           failures)
+        )
+
+    totals = report["totals"]
+    old_totals = baseline.get("totals", {})
+    total_budget = budget.get("totals", {})
+    print(
+        f"{'total':<28} {totals['flash']:>8} "
+        f"{fmt_delta(totals['flash'], old_totals.get('flash')):>8} "
+        f"{totals['ram']:>7} {fmt_delta(totals['ram'], old_totals.get('ram')):>7}"
+        + check_budget("total flash", totals["flash"],
+                       total_budget.get("flash"), failures)
+        + check_budget("total ram", totals["ram"], total_budget.get("ram"),
+                       failures)
+    )
+    print(
+        "  code {code}  iram {iram}  rodata {rodata}  data {data}  "
+        "bss {bss}".format(**totals)
+    )
+
+    firmware = report.get("firmware")
+    if firmware:
+        old_firmware = baseline.get("firmware", {})
+        firmware_budget = budget.get("firmware", {})
+        print(
+            f"{'linked firmware':<28} {firmware['flash']:>8} "
+            f"{fmt_delta(firmware['flash'], old_firmware.get('flash')):>8} "
+            f"{firmware['ram']:>7} "
+            f"{fmt_delta(firmware['ram'], old_firmware.get('ram')):>7}"
+            + check_budget("firmware flash", firmware["flash"],
+                           firmware_budget.get("flash"), failures)
+            + check_budget("firmware ram", firmware["ram"],
+                           firmware_budget.get("ram"), failures)
+        )
+
+    print(f"\n{'asset':<28} {'bytes':>8} {'delta':>8}")
+    old_assets = baseline.get("assets", {})
+    asset_budgets = budget.get("assets", {})
+    for name, size in report["assets"].items():
+        print(
+            f"{name:<28} {size:>8} {fmt_delta(size, old_assets.get(name)):>8}"
+            + check_budget(name, size, asset_budgets.get(name), failures)
+        )
+
+    print(f"\n{'largest symbols':<60} {'kind':>6} {'bytes':>8}")
+    for symbol in report["symbols"][:20]:
+        name = symbol["name"]
+        if len(name) > 58:
+            name = name[:55] + "..."
+        print(f"{name:<60} {symbol['kind']:>6} {symbol['size']:>8}")
+
+    if failures:
+        print(f"\n{len(failures)} over budget:")
+        for failure in failures:
+            print(f"  {failure}")
+    if budget.get("measured") is not True:
+        return []
+    return failures
+
+
+def load_json(path):
+    if not path or not os.path.exists(path):
+        return {}
+    with open(path, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("files", nargs="+", help="Object files or a linked ELF")
+    ap.add_argument("--objdump", default="objdump", help="objdump to use")
+    ap.add_argument("--elf", help="Linked firmware the objects went into")
+    ap.add_argument("--budget", help="Budget file (size_budget.json)")
+    ap.add_argument("--baseline", help="Earlier report to diff against")
+    ap.add_argument("--output", help="Write the report as JSON here")
+    ap.add_argument(
+        "--write-budget",
+        help="Write budgets derived from this report here (size_budget.json)",
+    )
+    ap.add_argument(
+        "--top", type=int, default=100, help="Symbols kept in the report"
+    )
+    args = ap.parse_args()
+
+    report = build_report(args.objdump, args.files, args.top, args.elf)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+    if args.write_budget:
+        source = os.path.basename(args.output) if args.output else "report"
+        with open(args.write_budget, "w", encoding="utf-8") as f:
+            json.dump(derive_budget(report, source), f, indent=2)
+            f.write("\n")
+        print(f"Wrote {args.write_budget}")
+        return 0
+
+    failures = print_report(
+        report, load_json(args.budget), load_json(args.baseline)
+    )
+    if args.output:
+        print(f"\nWrote {args.output}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
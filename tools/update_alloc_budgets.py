@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+update_alloc_budgets.py
+Rewrite the measured entries of test/native/src/alloc_budgets.h from the
+ALLOC_MEASURED lines test_allocation_budgets prints.
+
+Entries written as literal numbers are replaced with the measured
+allocations and peak bytes (the test adds the margin); macro entries such as
+the asset budgets are left alone. Measurements without an entry are listed
+so they can be added by hand. Once every literal entry has been measured,
+MAKER_API_ALLOC_BUDGETS_MEASURED is set to 1 so the test starts enforcing
+the budgets.
+
+Usage:
+    pio test -e test_native -v | python3 tools/update_alloc_budgets.py
+    python3 tools/update_alloc_budgets.py test_output.txt --dry-run
+"""
+import argparse
+import os
+import re
+import sys
+
+BUDGETS = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)),
+    "..", "test", "native", "src", "alloc_budgets.h",
+)
+MEASURED = re.compile(r'ALLOC_MEASURED "([^"]+)" (\d+) (\d+)')
+ENTRY = re.compile(r'\{"([^"]+)",(\s*)(\d+), (\d+)\}')
+UNMEASURED = "#define MAKER_API_ALLOC_BUDGETS_MEASURED 0\n"
+MEASURED_FLAG = "#define MAKER_API_ALLOC_BUDGETS_MEASURED 1\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("output", nargs="?", help="Test output (default: stdin)")
+    ap.add_argument("--budgets", default=BUDGETS, help="alloc_budgets.h path")
+    ap.add_argument(
+        "--dry-run", action="store_true", help="Print changes only"
+    )
+    args = ap.parse_args()
+
+    if args.output:
+        with open(args.output, "r", encoding="utf-8") as f:
+            text = f.read()
+    else:
+        text = sys.stdin.read()
+    measured = {
+        m.group(1): (int(m.group(2)), int(m.group(3)))
+        for m in MEASURED.finditer(text)
+    }
+    if not measured:
+        print("No ALLOC_MEASURED lines - run the native tests verbosely (-v)")
+        return 1
+
+    with open(args.budgets, "r", encoding="utf-8") as f:
+        header = f.read()
+
+    seen = set()
+
+    def replace(m):
+        name = m.group(1)
+        seen.add(name)
+        if name not in measured:
+            return m.group(0)
+        allocations, peak = measured[name]
+        old = (int(m.group(3)), int(m.group(4)))
+        if old != (allocations, peak):
+            print(f"{name:<40} {old[0]:>6} -> {allocations:<6} "
+                  f"{old[1]:>8} -> {peak} B")
+        return f'{{"{name}",{m.group(2)}{allocations}, {peak}}}'
+
+    updated = ENTRY.sub(replace, header)
+    unmeasured = sorted(seen - set(measured))
+    if unmeasured:
+        print("Not measured, budgets stay unenforced: " + ", ".join(unmeasured))
+    else:
+        updated = updated.replace(UNMEASURED, MEASURED_FLAG)
+    macro_entries = set(re.findall(r'\{"([^"]+)",\s*MAKER_API_', header))
+    for name in sorted(set(measured) - seen - macro_entries):
+        allocations, peak = measured[name]
+        print(f'No entry for {name} - add {{"{name}", {allocations}, {peak}}}')
+
+    if not args.dry_run and updated != header:
+        with open(args.budgets, "w", encoding="utf-8") as f:
+            f.write(updated)
+        print(f"Wrote {args.budgets}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())